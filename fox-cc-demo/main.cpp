@@ -1,83 +1,50 @@
 ﻿#include <iostream>
 #include <fstream>
+#include <sstream>
 #include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+#include <charconv>
 
 #include <fox_cc.hpp>
+#include <runtime/static_parser.hpp>
+
+#include <calc_lexer.hpp>
+#include <calc_parser.hpp>
 
 int main()
 {
-	std::string grammar = R"(
-%token	NUMBER		[0-9]+
-%token	OP_ADD		[+]
-%token	OP_SUB		[\-]
-%token	OP_MUL		[*]
-%token	OP_DIV		[/]
-%token	OP_MOD		[%]
-%token	L_PARENT	[(]
-%token	R_PARENT	[)]
-
-%start start
-
-%%
-start
-	:	expression	{ forward }
-	;
-
-expression
-	:	precedence_2 { forward }
-	;
-
-precedence_2
-	:	precedence_2 OP_ADD precedence_1 { bin_op }
-	|	precedence_2 OP_SUB precedence_1 { bin_op }
-	|	precedence_1					 { forward }
-	;
-
-precedence_1
-	:	precedence_1 OP_MUL precedence_0 { bin_op }
-	|	precedence_1 OP_DIV precedence_0 { bin_op }
-	|	precedence_1 OP_MOD precedence_0 { bin_op }
-	|	precedence_0					 { forward }
-	;
-
-precedence_0
-	:	NUMBER							{ forward }
-	|	L_PARENT expression R_PARENT	{ parent_exp }
-	;
-%%
-)";
-
-	fox_cc::compiler cmp(grammar);
-
-	cmp.register_action("forward", [](std::span<std::string> v)
+	std::string grammar;
 	{
-		return v[0];
-	});
-	cmp.register_action("bin_op", [](std::span<std::string> v)
+		std::ifstream in(FOX_CC_DEMO_GRAMMAR, std::ios::binary);
+		std::stringstream ss;
+		ss << in.rdbuf();
+		grammar = ss.str();
+	}
+
+	// Generated rather than taken from the grammar cache, the debug dumps below need the lexer DFA and the item sets
+	fox_cc::basic_compiler<int> cmp(grammar, false);
+
+	cmp.register_token_converter("NUMBER", [](const fox_cc::token_view& t)
 	{
-		auto lhs = std::stoi(v[0]);
-		auto rhs = std::stoi(v[2]);
-		int out;
-		switch (v[1][0])
-		{
-		case '+':
-			out = lhs + rhs; break;
-		case '-':
-			out = lhs - rhs; break;
-		case '*':
-			out = lhs * rhs; break;
-		case '/':
-			out = lhs / rhs; break;
-		case '%':
-			out = lhs % rhs; break;
-		default:
-			throw std::logic_error("Unknown operator.");
-		}
-
-		return std::to_string(out);
+		int out = 0;
+		std::from_chars(std::data(t.lexeme), std::data(t.lexeme) + std::size(t.lexeme), out);
+		return out;
 	});
 
-	cmp.register_action("parent_exp", [](std::span<std::string> v) { return v[1]; });
+	const std::unordered_map<std::string_view, int(*)(std::span<int>)> actions = {
+		{ "forward", [](std::span<int> v) { return v[0]; } },
+		{ "add", [](std::span<int> v) { return v[0] + v[2]; } },
+		{ "sub", [](std::span<int> v) { return v[0] - v[2]; } },
+		{ "mul", [](std::span<int> v) { return v[0] * v[2]; } },
+		{ "div", [](std::span<int> v) { return v[0] / v[2]; } },
+		{ "mod", [](std::span<int> v) { return v[0] % v[2]; } },
+		{ "parent_exp", [](std::span<int> v) { return v[1]; } },
+	};
+
+	for (const auto& [name, func] : actions)
+		cmp.register_action(std::string(name), func);
 
 	{
 		std::fstream f("lexer_debug.txt", std::ios::trunc | std::ios::out );
@@ -90,13 +57,52 @@ precedence_0
 		f << cmp.dot_to_string();
 	}
 
+	const std::string op = "1+2*(2+2)";
+
 	{
 		auto f = std::fstream("trace.txt", std::ios::trunc | std::ios::out);
-		std::string op = "1+2*(2+2)";
 		const auto computation_result = cmp.compile(op, f);
 		std::cout << op << "=" << computation_result << '\n';
+	}
 
+	{
+		// Same grammar, run from the tables fox_cc_generate built out of calc.grammar
+		std::string_view rest = op;
+		std::string_view lexeme;
+		std::vector<int> values;
+
+		fox_cc::static_parser<calc::tables> parser;
+		parser.parse(
+			[&]()
+			{
+				const auto m = calc::next_token(rest);
+				if (m.token == calc::token_npos)
+					throw std::logic_error("Unknown token whilst lexing the input");
+
+				lexeme = rest.substr(0, m.length);
+				rest.remove_prefix(m.length);
+				return m.token;
+			},
+			[&](size_t token)
+			{
+				int value = 0;
+				if (calc::token_names[token] == "NUMBER")
+					std::from_chars(std::data(lexeme), std::data(lexeme) + std::size(lexeme), value);
+
+				values.push_back(value);
+			},
+			[&](size_t production)
+			{
+				const size_t length = calc::tables::production_length[production];
+				const auto v = std::span<int>(values).last(length);
+				const int value = actions.at(calc::tables::production_actions[production])(v);
+
+				values.resize(std::size(values) - length);
+				values.push_back(value);
+			});
+
+		std::cout << op << "=" << values.back() << " (generated tables)\n";
 	}
-	
+
 	return 0;
 }
\ No newline at end of file
@@ -0,0 +1,58 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include <fox_cc.hpp>
+
+// fox-cc-gen <grammar> <lexer header> <parser header> <namespace> [--compressed]
+// Compiles the grammar and writes the direct-coded lexer and the LR tables, see fox_cc_generate in CMakeLists.txt
+int main(int argc, char** argv)
+{
+	const bool compressed = argc == 6 && std::string_view(argv[5]) == "--compressed";
+
+	if (argc != 5 && !compressed)
+	{
+		std::cerr << "usage: fox-cc-gen <grammar> <lexer header> <parser header> <namespace> [--compressed]\n";
+		return 1;
+	}
+
+	std::ifstream in(argv[1], std::ios::binary);
+	if (!in)
+	{
+		std::cerr << "fox-cc-gen: can't open " << argv[1] << '\n';
+		return 1;
+	}
+
+	std::stringstream ss;
+	ss << in.rdbuf();
+	const std::string grammar = ss.str();
+
+	try
+	{
+		// The emitters need the lexer DFA and the item sets, which a cache hit doesn't have
+		fox_cc::compiler cmp(grammar, false);
+
+		if (compressed)
+			cmp.set_parser_layout(fox_cc::parse_table_layout::compressed);
+
+		std::ofstream lexer(argv[2], std::ios::trunc | std::ios::out);
+		lexer << cmp.lexer_to_cpp(argv[4]);
+
+		std::ofstream parser(argv[3], std::ios::trunc | std::ios::out);
+		parser << cmp.parser_to_cpp(argv[4]);
+
+		if (!lexer || !parser)
+		{
+			std::cerr << "fox-cc-gen: can't write the output headers\n";
+			return 1;
+		}
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << "fox-cc-gen: " << e.what() << '\n';
+		return 1;
+	}
+
+	return 0;
+}
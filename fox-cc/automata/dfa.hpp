@@ -243,5 +243,213 @@ namespace fox_cc
 		{
 			return construct_dfa<Value, Reduce, Edge, EdgeTraits>(nfa, [](const Reduce& lhs, const Reduce& rhs) -> Reduce { return std::min(lhs, rhs); }, [](const Value& lhs, const Value& rhs) -> Value { return lhs; });
 		}
+
+		template
+		<
+			class Value,
+			class Reduce,
+			class Edge,
+			class EdgeTraits = ::fox_cc::automata::edge_traits<Edge>
+		>
+		dfa<Value, Reduce, Edge, EdgeTraits> minimize_dfa(const dfa<Value, Reduce, Edge, EdgeTraits>& source)
+		{
+			// Uses Hopcroft's partition refinement, states are told apart by their reduce and by where their edges lead.
+			// Values of merged states are taken from the first state of every group.
+			using edge_traits = EdgeTraits;
+
+			const size_t n = std::size(source);
+			const size_t sink = n; // implicit state all missing edges go to
+
+			// Split edges into symbols, every edge is an union of whole symbols
+			std::vector<Edge> symbols;
+			{
+				std::vector<Edge> edges;
+				for (const auto& state : source)
+				{
+					for (const auto& edge : state.next() | std::views::keys)
+						edges.push_back(edge);
+				}
+
+				symbols = edge_traits::unique_edges(edges);
+			}
+
+			const size_t k = std::size(symbols);
+
+			// Inverse transition function, inverse[symbol][state] are states that go to state by the symbol
+			std::vector<std::vector<std::vector<size_t>>> inverse(k, std::vector<std::vector<size_t>>(n + 1));
+			for (size_t s = 0; s <= n; ++s)
+			{
+				for (size_t a = 0; a < k; ++a)
+				{
+					size_t to = sink;
+
+					if (s != sink)
+					{
+						for (const auto& [edge, next_state] : source[s].next())
+						{
+							if (!edge_traits::empty_intersection(edge, symbols[a]))
+							{
+								to = next_state;
+								break;
+							}
+						}
+					}
+
+					inverse[a][to].push_back(s);
+				}
+			}
+
+			// Initial partition, by reduce
+			std::vector<std::vector<size_t>> blocks;
+			std::vector<size_t> block_of(n + 1);
+			{
+				std::map<std::optional<Reduce>, size_t> reduce_blocks;
+
+				for (size_t s = 0; s <= n; ++s)
+				{
+					const std::optional<Reduce> reduce = (s == sink) ? std::nullopt : source[s].reduce();
+
+					auto [it, inserted] = reduce_blocks.try_emplace(reduce, std::size(blocks));
+					if (inserted)
+						blocks.emplace_back();
+
+					blocks[it->second].push_back(s);
+					block_of[s] = it->second;
+				}
+			}
+
+			// Refine
+			std::vector<std::pair<size_t, size_t>> work; // (block, symbol) splitters
+			std::vector<bool> in_work(std::size(blocks) * k, false);
+
+			for (size_t b = 0; b < std::size(blocks); ++b)
+			{
+				for (size_t a = 0; a < k; ++a)
+				{
+					work.emplace_back(b, a);
+					in_work[b * k + a] = true;
+				}
+			}
+
+			std::vector<bool> marked(n + 1, false);
+			std::vector<size_t> marked_count;
+			std::vector<size_t> touched_blocks;
+			std::vector<size_t> predecessors;
+
+			while (!std::empty(work))
+			{
+				const auto [splitter, a] = work.back();
+				work.pop_back();
+				in_work[splitter * k + a] = false;
+
+				predecessors.clear();
+				for (auto s : blocks[splitter])
+					predecessors.insert(std::end(predecessors), std::begin(inverse[a][s]), std::end(inverse[a][s]));
+
+				marked_count.resize(std::size(blocks), 0);
+				touched_blocks.clear();
+
+				for (auto p : predecessors)
+				{
+					if (marked[p])
+						continue;
+
+					marked[p] = true;
+
+					if (marked_count[block_of[p]]++ == 0)
+						touched_blocks.push_back(block_of[p]);
+				}
+
+				for (auto b : touched_blocks)
+				{
+					if (marked_count[b] != std::size(blocks[b]))
+					{
+						// Split the block, marked states are moved to the new block
+						const size_t new_block = std::size(blocks);
+						blocks.emplace_back();
+						in_work.resize(std::size(blocks) * k, false);
+
+						auto& old_states = blocks[b];
+						auto& new_states = blocks.back();
+
+						for (auto s : old_states)
+						{
+							if (marked[s])
+							{
+								new_states.push_back(s);
+								block_of[s] = new_block;
+							}
+						}
+
+						std::erase_if(old_states, [&](size_t s) -> bool { return marked[s]; });
+
+						for (size_t c = 0; c < k; ++c)
+						{
+							size_t to_add = new_block;
+
+							if (!in_work[b * k + c] && std::size(blocks[b]) < std::size(blocks[new_block]))
+								to_add = b;
+
+							if (!in_work[to_add * k + c])
+							{
+								work.emplace_back(to_add, c);
+								in_work[to_add * k + c] = true;
+							}
+						}
+					}
+
+					marked_count[b] = 0;
+				}
+
+				for (auto p : predecessors)
+					marked[p] = false;
+			}
+
+			// Build the minimal DFA, numbering blocks in order of their first state so the start state stays first
+			dfa<Value, Reduce, Edge, EdgeTraits> out;
+
+			std::vector<size_t> block_state(std::size(blocks), dfa<Value, Reduce, Edge, EdgeTraits>::state_id_npos);
+			std::vector<size_t> representative;
+
+			for (size_t s = 0; s < n; ++s)
+			{
+				const auto b = block_of[s];
+
+				if (block_state[b] != out.state_id_npos)
+					continue;
+
+				// Block of states that never accept, unless it's the start state
+				if (b == block_of[sink] && s != source.start())
+					continue;
+
+				block_state[b] = out.insert();
+				representative.push_back(s);
+
+				out[block_state[b]].reduce() = source[s].reduce();
+				out[block_state[b]].value() = source[s].value();
+			}
+
+			for (size_t i = 0; i < std::size(representative); ++i)
+			{
+				for (const auto& [edge, next_state] : source[representative[i]].next())
+				{
+					const auto to = block_state[block_of[next_state]];
+
+					if (to != out.state_id_npos)
+						out.connect(i, to, edge);
+				}
+			}
+
+			if (source.start() != source.state_id_npos)
+				out.start() = block_state[block_of[source.start()]];
+
+			for (auto s : source.accept())
+			{
+				if (block_state[block_of[s]] != out.state_id_npos)
+					out.accept().insert(block_state[block_of[s]]);
+			}
+
+			return out;
+		}
 	}
 }
\ No newline at end of file
@@ -2,15 +2,30 @@
 
 #include <vector>
 #include <string>
+#include <algorithm>
 #include <cassert>
 #include <bitset>
 #include <functional>
 #include <sstream>
+#include <type_traits>
+#include <utility>
 
 #include <internal_parser/lexer.hpp>
 #include <internal_parser/parser.hpp>
 #include <lex_compiler/lex_compiler.hpp>
+#include <lex_compiler/lex_table.hpp>
+#include <lex_compiler/lex_emitter.hpp>
 #include <parser_compiler/parser_compiler.hpp>
+#include <parser_compiler/parse_table.hpp>
+#include <runtime/input.hpp>
+#include <runtime/mapped_file.hpp>
+#include <runtime/tokenizer.hpp>
+#include <runtime/static_parser.hpp>
+#include <runtime/grammar_file.hpp>
+#include <runtime/grammar_cache.hpp>
+#include <runtime/parse_session.hpp>
+#include <runtime/parse_trace.hpp>
+#include <runtime/generator.hpp>
 
 namespace fox_cc
 {
@@ -99,36 +114,106 @@ namespace fox_cc
 		ast_node root;
 	};
 
-	class compiler
+	// Value is the type of the semantic values, terminals become values through token converters, see
+	// register_token_converter
+	template<class Value = std::string>
+	class basic_compiler
 	{
+	public:
+		using value_type = Value;
+
+		using action = std::function<Value(std::span<Value>)>;
+
+		// Receives terminals as views of the input, valid only for the duration of the call. Non-terminals are viewed
+		// when Value converts to std::string_view and empty otherwise
+		using view_action = std::function<Value(std::span<const token_view>)>;
+
+		using token_converter = std::function<Value(const token_view&)>;
+
+	private:
 		lex_compiler::lex_compiler_result lexer_;
 		parser_compiler::parser_compiler_result parser_;
+		fox_cc::tokenizer tokenizer_;
+		fox_cc::parse_table parse_table_;
+
+		using bound_action = std::variant<std::monostate, action, view_action>;
 
-		std::unordered_map<std::string, std::function<std::string(std::span<std::string>)>> actions_;
+		std::unordered_map<std::string, std::variant<action, view_action>> actions_;
+		std::vector<bound_action> bound_actions_; // [action slot] -> action of actions_, monostate if it isn't registered
+		std::unordered_map<std::string, token_converter> converters_;
+		std::vector<token_converter> terminal_converters_; // [terminal] -> converter of converters_, empty if it has none
 
 	public:
-		void register_action(const std::string& name, const std::function<std::string(std::span<std::string>)>& func)
+		// Throws std::logic_error if no production of the grammar has the action
+		void register_action(const std::string& name, const action& func)
 		{
+			const size_t slot = action_slot(name);
 			actions_[name] = func;
+			bound_actions_[slot] = func;
 		}
 
-	public:
-		compiler() = delete;
+		// Throws std::logic_error if no production of the grammar has the action
+		void register_view_action(const std::string& name, const view_action& func)
+		{
+			const size_t slot = action_slot(name);
+			actions_[name] = func;
+			bound_actions_[slot] = func;
+		}
 
-		compiler(std::string_view language)
+		// Converts the lexemes of the terminal before they are passed to actions. Terminals without a converter are
+		// constructed from their lexeme when Value is constructible from std::string_view and default constructed
+		// otherwise. Throws std::logic_error if the grammar has no such terminal
+		void register_token_converter(const std::string& terminal, const token_converter& func)
 		{
-			this->assign(language);
+			const auto terminals = std::span(parse_table_.symbol_names()).first(parse_table_.terminal_count());
+			if (std::ranges::find(terminals, terminal) == std::end(terminals))
+				throw std::logic_error("Unknown terminal.");
+
+			converters_[terminal] = func;
+			bind();
 		}
 
-		compiler(const compiler&) = default;
+		void set_lexer_mode(lexer_mode mode) noexcept
+		{
+			tokenizer_.set_mode(mode);
+		}
 
-		compiler(compiler&&) noexcept = default;
+		[[nodiscard]] lexer_mode get_lexer_mode() const noexcept
+		{
+			return tokenizer_.mode();
+		}
 
-		compiler& operator=(const compiler&) = default;
+		// Compressed tables are an order of magnitude smaller for large grammars, at the cost of a check per lookup
+		void set_parser_layout(parse_table_layout layout)
+		{
+			if (layout != parse_table_.layout())
+				parse_table_ = parse_table_.with_layout(layout);
+		}
 
-		compiler& operator=(compiler&&) noexcept = default;
+		[[nodiscard]] parse_table_layout get_parser_layout() const noexcept
+		{
+			return parse_table_.layout();
+		}
 
-		~compiler() noexcept = default;
+	private:
+		basic_compiler() = default;
+
+	public:
+		// See assign()
+		basic_compiler(std::string_view language, bool use_cache = true)
+		{
+			this->assign(language, use_cache);
+		}
+
+		basic_compiler(const basic_compiler&) = default;
+
+		basic_compiler(basic_compiler&&) noexcept = default;
+
+		basic_compiler& operator=(const basic_compiler&) = default;
+
+		basic_compiler& operator=(basic_compiler&&) noexcept = default;
+
+		~basic_compiler() noexcept = default;
 
 	public:
 		const lex_compiler::lex_compiler_result& lexer() const noexcept
@@ -141,9 +226,36 @@ namespace fox_cc
 			return parser_;
 		}
 
+		const fox_cc::lex_table& lexer_table() const noexcept
+		{
+			return tokenizer_.table();
+		}
+
+		const fox_cc::tokenizer& tokenizer() const noexcept
+		{
+			return tokenizer_;
+		}
+
+		const fox_cc::parse_table& parser_table() const noexcept
+		{
+			return parse_table_;
+		}
+
 	public:
-		void assign(std::string_view language)
+		// Reuses the tables of the grammar cache when FOX_CC_CACHE_DIR is set, see grammar_cache.hpp. The generator
+		// doesn't run on a hit, so the grammar is then like a loaded one: lexer() and parser() are empty, the debug
+		// dumps have nothing to show and lexer_to_cpp() throws. Pass use_cache = false where the generator's output is
+		// needed
+		void assign(std::string_view language, bool use_cache = true)
 		{
+			if (auto cached = use_cache ? load_cached_grammar(language) : std::nullopt)
+			{
+				const auto layout = parse_table_.layout();
+				this->assign(std::move(*cached));
+				this->set_parser_layout(layout);
+				return;
+			}
+
 			prs::lexer lx(language);
 			prs::parser ps(lx);
 			ps.parse();
@@ -151,8 +263,93 @@ namespace fox_cc
 
 			fox_cc::lex_compiler lex_cmp(ast);
 			lexer_ = lex_cmp.result();
+			tokenizer_ = fox_cc::tokenizer(fox_cc::lex_table(lexer_), tokenizer_.mode());
 			fox_cc::parser_compiler prs_cmp(lexer_, ast);
 			parser_ = prs_cmp.result();
+			parse_table_ = fox_cc::parse_table(parser_, parse_table_.layout());
+			bind();
+
+			if (use_cache)
+				store_cached_grammar(language, grammar_file{ lexer_.terminals, tokenizer_.table(), parse_table_, std::string(language) });
+		}
+
+		// Writes the compiled grammar, see grammar_file.hpp. Registered actions aren't saved
+		void save(const std::filesystem::path& path) const
+		{
+			save_grammar(path, grammar_file{ lexer_.terminals, tokenizer_.table(), parse_table_ });
+		}
+
+		// Compiler of a grammar written by save(), without running the generator. The lexer DFA and the LR item sets
+		// aren't stored, so lexer_to_string(), lexer_to_cpp(), parser_to_string() and dot_to_string() have nothing to show
+		[[nodiscard]] static basic_compiler load(const std::filesystem::path& path)
+		{
+			basic_compiler out;
+			out.assign(load_grammar(path));
+			return out;
+		}
+
+	private:
+		void assign(grammar_file&& file)
+		{
+			lexer_ = {};
+			lexer_.terminals = std::move(file.terminals);
+			tokenizer_ = fox_cc::tokenizer(std::move(file.lexer), tokenizer_.mode());
+			parse_table_ = std::move(file.parser);
+			parser_ = {};
+			bind();
+		}
+
+		// Actions and converters are registered by name and kept across grammars, the ones the current grammar uses
+		// are bound to its action slots and terminal ids
+		void bind()
+		{
+			const auto& names = parse_table_.action_names();
+			bound_actions_.assign(std::size(names), std::monostate{});
+
+			for (size_t i = 0; i < std::size(names); ++i)
+			{
+				if (auto f = actions_.find(names[i]); f != std::end(actions_))
+					std::visit([&](const auto& func) { bound_actions_[i] = func; }, f->second);
+			}
+
+			terminal_converters_.assign(parse_table_.terminal_count(), {});
+
+			for (size_t i = 0; i < parse_table_.terminal_count(); ++i)
+			{
+				if (auto f = converters_.find(parse_table_.symbol_name(i)); f != std::end(converters_))
+					terminal_converters_[i] = f->second;
+			}
+		}
+
+		[[nodiscard]] size_t action_slot(const std::string& name) const
+		{
+			const auto& names = parse_table_.action_names();
+			const auto f = std::ranges::find(names, name);
+
+			if (f == std::end(names))
+				throw std::logic_error("Unknown action.");
+
+			return static_cast<size_t>(f - std::begin(names));
+		}
+
+		void convert_terminal(size_t id, std::string_view lexeme, Value& out) const
+		{
+			if (const auto& f = terminal_converters_[id])
+				out = f(token_view{ id, lexeme });
+			else if constexpr (std::is_assignable_v<Value&, std::string_view>)
+				out = lexeme; // reuses the capacity of out
+			else if constexpr (std::is_constructible_v<Value, std::string_view>)
+				out = Value(lexeme);
+			else
+				out = Value{};
+		}
+
+		[[nodiscard]] static std::string_view value_view(const Value& value) noexcept
+		{
+			if constexpr (std::is_convertible_v<const Value&, std::string_view>)
+				return value;
+			else
+				return {};
 		}
 
 	public:
@@ -211,6 +408,7 @@ namespace fox_cc
 
 			auto& out = lexer_.dfa;
 
+			ss << "states: " << lexer_.minimized_dfa_states << " (" << lexer_.dfa_states << " before minimization)\n";
 			ss << "============\n";
 
 			for (size_t i = 0; i < out.size(); ++i)
@@ -249,6 +447,19 @@ namespace fox_cc
 			return ss.str();
 		}
 
+		// Standalone C++ header with a direct-coded scanner for the lexer, see emit_lexer_cpp. Throws std::logic_error
+		// for loaded and cached grammars, which don't keep the lexer DFA
+		[[nodiscard]] std::string lexer_to_cpp(std::string_view name_space = "fox_cc_lexer") const
+		{
+			return emit_lexer_cpp(lexer_, name_space);
+		}
+
+		// Standalone C++ header with the flattened LR tables, run by static_parser
+		[[nodiscard]] std::string parser_to_cpp(std::string_view name_space = "fox_cc_parser") const
+		{
+			return emit_parser_cpp(parse_table_, name_space);
+		}
+
 		[[nodiscard]] std::string dot_to_string() const 
 		{
 			std::stringstream ss;
@@ -300,253 +511,898 @@ namespace fox_cc
 		}
 
 	public:
-		[[nodiscard]] std::string compile(std::string_view input) const
+		[[nodiscard]] Value compile(std::string_view input) const
 		{
-			std::stringstream ss;
-			return compile(input, ss);
+			parse_session<Value> session;
+			return compile(input, session);
 		}
 
-		[[nodiscard]] std::string compile(std::string_view input, std::ostream& os) const
+		[[nodiscard]] Value compile(std::string_view input, std::ostream& os) const
 		{
-			// TODO: Else
-			assert(std::size(input) >= 2);
+			parse_session<Value> session;
+			return compile(input, session, os);
+		}
 
-			ast out;
+		// Reuses the stacks of the session, see parse_session
+		[[nodiscard]] Value compile(std::string_view input, parse_session<Value>& session) const
+		{
+			no_trace trace;
+			return compile(input, session, trace);
+		}
 
-			char c0 = 0, c1 = input[0];
+		[[nodiscard]] Value compile(std::string_view input, parse_session<Value>& session, std::ostream& os) const
+		{
+			stream_trace trace(os);
+			return compile(input, session, trace);
+		}
 
-			auto& lexer = lexer_.dfa;
-			auto& parser = parser_.dfa;
+		// Every step is reported to the trace, see parse_trace.hpp
+		template<class Trace> requires parse_trace<Trace, Value>
+		[[nodiscard]] Value compile(std::string_view input, parse_session<Value>& session, Trace& trace) const
+		{
+			return compile_input(string_input(input), session, trace);
+		}
 
-			size_t current_lexer_node = lexer.start();
+		// Streams the input from the source, only a window of it is kept in memory
+		[[nodiscard]] Value compile(chunk_source source) const
+		{
+			parse_session<Value> session;
+			no_trace trace;
+			return compile_input(chunked_input(std::move(source)), session, trace);
+		}
 
-			size_t potential_reduce_i = std::numeric_limits<size_t>::max();
-			size_t potential_reduce_node = current_lexer_node;
+		[[nodiscard]] Value compile(chunk_source source, std::ostream& os) const
+		{
+			parse_session<Value> session;
+			stream_trace trace(os);
+			return compile_input(chunked_input(std::move(source)), session, trace);
+		}
 
-			size_t token_start = 0;
+		[[nodiscard]] Value compile(std::istream& is) const
+		{
+			return compile(istream_source(is));
+		}
 
-			std::vector<ast::terminal> lexer_tokens;
+		[[nodiscard]] Value compile(std::istream& is, std::ostream& os) const
+		{
+			return compile(istream_source(is), os);
+		}
 
-			os << "node [symbol] node [symbol] ...\n";
+		// Maps the file and lexes it in place, without copying it into memory first
+		[[nodiscard]] Value compile_file(const std::filesystem::path& path) const
+		{
+			const mapped_file file(path);
+			parse_session<Value> session;
+			no_trace trace;
+			return compile_input(string_input(file.view()), session, trace);
+		}
 
-			auto lexer_function = [&, lexer_i = static_cast<size_t>(0)](size_t& out_start, size_t& out_end) mutable -> size_t
+		[[nodiscard]] Value compile_file(const std::filesystem::path& path, std::ostream& os) const
+		{
+			const mapped_file file(path);
+			parse_session<Value> session;
+			stream_trace trace(os);
+			return compile_input(string_input(file.view()), session, trace);
+		}
+
+	public:
+		// Parses an input fed in fragments as they arrive. The lexer and the LR stacks are kept between feeds, every
+		// token is parsed as soon as it is complete and only the bytes of the unfinished one are kept. Lexes in the
+		// compiler's lexer mode, the compiler must outlive the session and stay in place
+		class push_session
+		{
+			const basic_compiler* compiler_;
+			tokenizer::push_scanner scanner_;
+			parse_session<Value> session_;
+
+		public:
+			push_session() = delete;
+
+			explicit push_session(const basic_compiler& compiler)
+				: compiler_(std::addressof(compiler)), scanner_(compiler.tokenizer_.push_scan())
 			{
-				std::size_t ts = lexer_i;
-				for (; lexer_i <= std::size(input); ++lexer_i)
+				session_.reset();
+			}
+
+			push_session(const push_session&) = default;
+			push_session(push_session&&) noexcept = default;
+			push_session& operator=(const push_session&) = default;
+			push_session& operator=(push_session&&) noexcept = default;
+			~push_session() noexcept = default;
+
+		public:
+			void feed(std::string_view bytes)
+			{
+				no_trace trace;
+
+				scanner_.feed(bytes, [&](const token& t)
 				{
-					c0 = (lexer_i < std::size(input)) ? input[lexer_i] : 0;
-					c1 = (lexer_i + 1 < std::size(input)) ? input[lexer_i + 1] : 0;
+					// Lexemes view the scanner's pending bytes, so terminals are copied
+					compiler_->run_default_reductions(session_, trace);
+					compiler_->push_token(session_, t.id, t.lexeme, false, trace);
+				});
+
+				compiler_->run_default_reductions(session_, trace);
+			}
+
+			// Ends the input and returns its value, the session is ready for the next input afterwards
+			[[nodiscard]] Value finish()
+			{
+				no_trace trace;
+
+				scanner_.finish([&](const token& t)
+				{
+					compiler_->run_default_reductions(session_, trace);
+					compiler_->push_token(session_, t.id, t.lexeme, false, trace);
+				});
+
+				auto out = compiler_->take_result(session_);
+				session_.reset();
+				return out;
+			}
+
+			// Drops the input fed so far, needed after feed() or finish() threw
+			void reset()
+			{
+				scanner_.reset();
+				session_.reset();
+			}
+		};
+
+		[[nodiscard]] push_session push() const
+		{
+			return push_session(*this);
+		}
+
+		// Keeps the parse of a text between edits. An edit relexes the tokens around it and reparses only what it
+		// damaged: subtrees of the previous parse are reused whole when the parser reaches them in the state they were
+		// built in and the token after them is unchanged, so their actions aren't run again. The nodes above the damage
+		// are reduced again from their unchanged children without reparsing them, see graft(), but their actions run
+		// again, so the spine of a left-recursive list edited near its start costs one action per element after the
+		// edit. Values are moved into the tree once their parent's action has read them, so actions must not move from
+		// their arguments. The compiler must outlive the session and stay in place
+		class incremental_session
+		{
+			static inline constexpr std::uint32_t npos = std::numeric_limits<std::uint32_t>::max();
+
+			// Node of the parse tree, terminals are its leaves
+			struct node
+			{
+				size_t id; // terminal or non-terminal
+				size_t production; // production a non-terminal was reduced by
+				std::uint32_t state; // state exposed below the node, it was entered by go_to(state, id)
+				size_t width; // tokens covered
+				Value value; // value of a non-terminal, held by the value stack instead while the node is on it
+				std::vector<std::uint32_t> children;
+			};
+
+			// Trace of the reparse, builds the nodes of the reduces. Shifts are recorded by step()
+			class tree_builder
+			{
+				incremental_session* session_;
+
+			public:
+				explicit tree_builder(incremental_session& session) noexcept
+					: session_(std::addressof(session)) {}
+
+			public:
+				void begin() noexcept {}
+
+				void shift(const parse_session<Value>&, size_t) noexcept {}
+
+				void pop(const parse_session<Value>&, size_t production)
+				{
+					session_->keep(production);
+				}
+
+				void reduce(const parse_session<Value>&, size_t production)
+				{
+					session_->build(production);
+				}
+			};
+
+			const basic_compiler* compiler_;
+			std::string text_;
+			token_buffer tokens_;
+
+			std::vector<node> nodes_;
+			std::vector<std::uint32_t> free_; // released slots of nodes_
+			std::uint32_t root_ = npos; // npos if the last parse failed
+
+			parse_session<Value> session_;
+			std::vector<std::uint32_t> stack_; // [value] -> node, parallel to the value stack of session_
+			std::vector<std::uint32_t> input_; // subtrees of the previous parse not read yet, the next one on top
+			size_t reused_ = 0;
+
+			// Node of the previous parse broken down into input_, kept until its first child is parsed again
+			struct broken
+			{
+				std::uint32_t node;
+				size_t mark; // size of input_ below its children
+				size_t first; // id of its first child
+			};
+
+			std::vector<broken> broken_;
 
-					auto& node = lexer[current_lexer_node];
+		public:
+			incremental_session() = delete;
 
-					if (node.reduce())
+			// Throws as compile() does
+			incremental_session(const basic_compiler& compiler, std::string text)
+				: compiler_(std::addressof(compiler))
+			{
+				const size_t size = std::size(text);
+				text_ = std::move(text);
+				reparse(compiler.tokenizer_.retokenize(text_, text_edit{ 0, 0, size }, tokens_));
+			}
+
+			incremental_session(const incremental_session&) = default;
+			incremental_session(incremental_session&&) noexcept = default;
+			incremental_session& operator=(const incremental_session&) = default;
+			incremental_session& operator=(incremental_session&&) noexcept = default;
+			~incremental_session() noexcept = default;
+
+		public:
+			[[nodiscard]] const std::string& text() const noexcept
+			{
+				return text_;
+			}
+
+			[[nodiscard]] const token_buffer& tokens() const noexcept
+			{
+				return tokens_;
+			}
+
+			// Value of the text, only after a parse that didn't throw
+			[[nodiscard]] const Value& value() const noexcept
+			{
+				assert(root_ != npos);
+				return nodes_[root_].value;
+			}
+
+			// Tokens the last parse took in reused subtrees
+			[[nodiscard]] size_t reused_tokens() const noexcept
+			{
+				return reused_;
+			}
+
+			// Replaces removed bytes at offset with inserted and returns the new value. If the new text doesn't lex the
+			// edit is undone, if it doesn't parse it is kept and the next edit parses the text whole
+			const Value& edit(size_t offset, size_t removed, std::string_view inserted)
+			{
+				if (offset > std::size(text_) || removed > std::size(text_) - offset)
+					throw std::out_of_range("Edit past the end of the text.");
+
+				const std::string erased = text_.substr(offset, removed);
+				text_.replace(offset, removed, inserted);
+
+				token_splice d{};
+				try
+				{
+					d = compiler_->tokenizer_.retokenize(text_, text_edit{ offset, removed, std::size(inserted) }, tokens_);
+				}
+				catch (...)
+				{
+					text_.replace(offset, std::size(inserted), erased);
+					throw;
+				}
+
+				reparse(d);
+				return value();
+			}
+
+		private:
+			// Parses the tokens, reading the ones outside the damage from the previous tree. A subtree of it ending
+			// right before the damage isn't reused, its last reduce saw a token that changed
+			void reparse(token_splice d)
+			{
+				const auto& compiler = *compiler_;
+				const auto& table = compiler.parse_table_;
+
+				input_.clear();
+				stack_.clear();
+				broken_.clear();
+				session_.reset();
+				reused_ = 0;
+
+				if (root_ != npos)
+					input_.push_back(std::exchange(root_, npos));
+				else
+					d = token_splice{ 0, 0, std::size(tokens_) };
+
+				size_t old = 0; // token of the previous parse the top of input_ starts at
+				size_t next = 0; // token the parser reads next
+
+				try
+				{
+					while (true)
 					{
-						if (potential_reduce_i == lexer_i) // Reduce
-						{
-							lexer_tokens.push_back(
-								ast::terminal{
-								lexer_.terminals[node.reduce().value()].name,
-								static_cast<std::string>(input.substr(ts, 
-								lexer_i - ts))
-								});
-
-							out_start = token_start;
-							out_end = potential_reduce_i;
-							token_start = potential_reduce_i + 1;
-							potential_reduce_i = std::numeric_limits<size_t>::max();
-							current_lexer_node = lexer.start();
-							return node.reduce().value();
-						}
-						else // Try matching longer string
+						// Next subtree or terminal of the input, npos for a token of the damage
+						std::uint32_t subtree = npos;
+
+						if (old != d.first || next == d.first + d.count)
 						{
-							potential_reduce_i = lexer_i;
-							potential_reduce_node = current_lexer_node;
+							while (!std::empty(input_))
+							{
+								const auto n = input_.back();
+								const size_t end = old + nodes_[n].width;
+								const bool terminal = nodes_[n].id < table.terminal_count();
+
+								if (old >= d.first && old < d.last)
+								{
+									if (!terminal)
+									{
+										break_down();
+										continue;
+									}
+
+									input_.pop_back();
+									free_.push_back(n);
+									++old;
+								}
+								else if (end == old)
+								{
+									break_down();
+								}
+								else if (!terminal && end >= d.first && old < d.last)
+								{
+									break_down();
+								}
+								else
+								{
+									subtree = n;
+									break;
+								}
+							}
 						}
-					}
 
-					if (lexer_i == std::size(input) && potential_reduce_i == std::numeric_limits<size_t>::max())
-					{
-						out_start = out_end = std::size(input);
-						lexer_tokens.push_back(
-							ast::terminal{lexer_.terminals[0].name }
-						);
-						return 0;
+						const size_t id = next < std::size(tokens_) ? tokens_.id(next) : token::end_token;
+
+						if (step(subtree, id, old, next, d))
+							break;
 					}
 
-					bool matched = false;
-					for (auto& n = node.next(); auto & c : n)
+					root_ = stack_.back();
+					nodes_[root_].value = std::move(session_.values_[session_.depth_ - 1]);
+
+					while (!std::empty(input_))
+						break_down();
+
+					for (const auto& b : broken_)
+						free_.push_back(b.node);
+
+					broken_.clear();
+				}
+				catch (...)
+				{
+					nodes_.clear();
+					free_.clear();
+					input_.clear();
+					stack_.clear();
+					broken_.clear();
+					throw;
+				}
+			}
+
+			// Reduces by the lookahead until the subtree or terminal is shifted. Returns true if a reduce finished the
+			// parse instead
+			bool step(std::uint32_t subtree, size_t id, size_t& old, size_t& next, const token_splice& d)
+			{
+				const auto& compiler = *compiler_;
+				const auto& table = compiler.parse_table_;
+
+				tree_builder builder(*this);
+				const auto to = compiler.reduce_lookahead(session_, id, builder);
+
+				if (to == parse_table::goto_npos)
+					return true;
+
+				if (graft(old, next, d))
+					return false;
+
+				const auto state = session_.states_.back();
+
+				// A non-terminal is shifted whole by its goto, where the lookahead, its first terminal, would be
+				if (subtree != npos && nodes_[subtree].id >= table.terminal_count())
+				{
+					const auto subtree_to = table.go_to(state, nodes_[subtree].id);
+
+					if (nodes_[subtree].state != state || subtree_to == parse_table::goto_npos)
 					{
-						if (c.first.test(c0))
-						{
-							matched = true;
-							current_lexer_node = c.second;
-							break;
-						}
+						break_down();
+						return false;
 					}
 
-					if (matched == false)
+					const size_t slot = session_.push();
+					session_.values_[slot] = std::move(nodes_[subtree].value);
+					session_.symbols_[slot].id = nodes_[subtree].id;
+					session_.states_.push_back(subtree_to);
+
+					input_.pop_back();
+					stack_.push_back(subtree);
+					old += nodes_[subtree].width;
+					next += nodes_[subtree].width;
+					reused_ += nodes_[subtree].width;
+					return false;
+				}
+
+				const auto lexeme = std::string_view(text_).substr(tokens_.begin(next), tokens_.length(next));
+				compiler.shift(session_, id, lexeme, true, to);
+
+				// Terminals of the previous parse keep their leaf
+				auto n = subtree;
+				if (n != npos)
+				{
+					input_.pop_back();
+					++old;
+				}
+				else
+				{
+					n = allocate();
+				}
+
+				auto& leaf = nodes_[n];
+				leaf.id = id;
+				leaf.state = state;
+				leaf.width = 1;
+				leaf.children.clear();
+
+				stack_.push_back(n);
+				++next;
+				return false;
+			}
+
+			// Reduces a node of the previous parse again once its first child is parsed again, as the same non-terminal
+			// from the same state, when its other children and the token after it are unchanged. The parser would shift
+			// them and reduce the same production, so only the action runs. The spine of a left-recursive list edited near
+			// its start is rebuilt this way rather than reparsed. Returns false if the node on top of the stack isn't one
+			bool graft(size_t& old, size_t& next, const token_splice& d)
+			{
+				const auto& compiler = *compiler_;
+				const auto& table = compiler.parse_table_;
+
+				while (!std::empty(broken_))
+				{
+					const auto [p, mark, first] = broken_.back();
+					const auto& children = nodes_[p].children;
+					const size_t rest = std::size(children) - 1;
+
+					// Its first child isn't parsed yet
+					if (std::size(input_) > mark + rest)
+						return false;
+
+					const auto to = table.go_to(nodes_[p].state, nodes_[p].id);
+
+					// Reduces finishing the parse are left to the parser, they check the end of the input
+					const bool matches = std::size(input_) == mark + rest && old >= d.last && to != parse_table::goto_npos
+						&& !std::empty(stack_) && nodes_[stack_.back()].id == first && nodes_[stack_.back()].state == nodes_[p].state
+						&& std::equal(std::begin(children) + 1, std::end(children), std::rbegin(input_));
+
+					broken_.pop_back();
+					free_.push_back(p); // build() takes the slot back
+
+					if (!matches)
+						continue;
+
+					for (size_t i = 1; i <= rest; ++i)
 					{
-						if (potential_reduce_i == std::numeric_limits<size_t>::max())
+						const auto c = children[i];
+						const auto& child = nodes_[c];
+						const bool terminal = child.id < table.terminal_count();
+
+						// State the child goes to, the next one was built in it
+						const auto after = i < rest ? nodes_[children[i + 1]].state
+							: terminal ? static_cast<std::uint32_t>(parse_table::operand(table.action(child.state, child.id)))
+							: table.go_to(child.state, child.id);
+
+						if (terminal)
 						{
-							throw "Unknown token\n";
+							const auto lexeme = std::string_view(text_).substr(tokens_.begin(next), tokens_.length(next));
+							compiler.shift(session_, child.id, lexeme, true, after);
 						}
 						else
 						{
-							lexer_i = potential_reduce_i - 1;
-							current_lexer_node = potential_reduce_node;
+							const size_t slot = session_.push();
+							session_.values_[slot] = std::move(nodes_[c].value);
+							session_.symbols_[slot].id = child.id;
+							session_.states_.push_back(after);
+							reused_ += child.width;
 						}
+
+						input_.pop_back();
+						stack_.push_back(c);
+						old += child.width;
+						next += child.width;
 					}
+
+					tree_builder builder(*this);
+					compiler.reduce(session_, nodes_[p].production, to, builder);
+					return true;
 				}
 
-				if (potential_reduce_i != std::numeric_limits<size_t>::max())
+				return false;
+			}
+
+			// Moves the values of the right-hand side into their nodes, the action has read them and the reduce pops them
+			void keep(size_t production)
+			{
+				const auto& table = compiler_->parse_table_;
+				const size_t length = table.production_length(production);
+
+				for (size_t i = 0; i < length; ++i)
 				{
-					if(potential_reduce_i != std::size(input) - 1)
-					{
-						throw "Error";
-					}
-					else
-					{
-						out_start = token_start;
-						out_end = potential_reduce_i;
-						potential_reduce_i = std::numeric_limits<size_t>::max();
-						assert(false); // This should be a dead path
-						return lexer[potential_reduce_node].reduce().value();
-					}
+					auto& child = nodes_[stack_[std::size(stack_) - length + i]];
+
+					if (child.id >= table.terminal_count())
+						child.value = std::move(session_.values_[session_.depth_ - length + i]);
 				}
+			}
 
-				lexer_tokens.push_back(
-					ast::terminal{ lexer_.terminals[0].name }
-				);
-				return {};
-			};
+			// Makes the node of a reduce, whose children are the nodes of its right-hand side
+			void build(size_t production)
+			{
+				const auto& table = compiler_->parse_table_;
+				const size_t length = table.production_length(production);
+
+				const auto n = allocate();
+				auto& parent = nodes_[n];
+				parent.id = table.production_lhs(production);
+				parent.production = production;
+				parent.state = session_.states_[session_.depth_ - 1];
+				parent.width = 0;
+				parent.children.assign(std::end(stack_) - length, std::end(stack_));
+
+				for (const auto child : parent.children)
+					parent.width += nodes_[child].width;
+
+				stack_.resize(std::size(stack_) - length);
+				stack_.push_back(n);
+			}
 
-			size_t start, end;
+			// Replaces the subtree on top of the input with its children, the subtree is kept for graft() if it has more
+			// than one
+			void break_down()
+			{
+				const auto n = input_.back();
+				input_.pop_back();
 
-			std::vector<size_t> reduction_stack;
-			std::vector<std::string> value_stack;
-			//reduction_stack.push_back(parser.start());
-			reduction_stack.push_back(0);
+				const auto& children = nodes_[n].children;
 
-			size_t e0 = lexer_function(start, end);
-			size_t e1 = lexer_function(start, end);
-			auto next_token = [&]() {e0 = e1; e1 = lexer_function(start, end); };
+				if (std::size(children) > 1)
+					broken_.push_back(broken{ n, std::size(input_), nodes_[children.front()].id });
+				else
+					free_.push_back(n);
 
-			bool modified = true;
-			while(modified)
-			{
-				modified = false;
-				size_t state_id = reduction_stack.back();
+				input_.insert(std::end(input_), std::rbegin(children), std::rend(children));
+			}
 
-				auto r = parser[state_id].value().action_table.find(e0);
-				if (r == std::end(parser[state_id].value().action_table))
+			[[nodiscard]] std::uint32_t allocate()
+			{
+				if (!std::empty(free_))
 				{
-					throw std::logic_error("Compilation error at token...");
+					const auto n = free_.back();
+					free_.pop_back();
+					return n;
 				}
 
-				if (std::holds_alternative<parser_compiler::parser_compiler_result::state_data::action_shift>(r->second))
+				nodes_.emplace_back();
+				return static_cast<std::uint32_t>(std::size(nodes_) - 1);
+			}
+		};
+
+		[[nodiscard]] incremental_session incremental(std::string text) const
+		{
+			return incremental_session(*this, std::move(text));
+		}
+
+		// Runs the parser over the input without actions and yields its shifts and reduces as they happen, the caller
+		// builds whatever it needs from them. Destroying the generator stops the parse. The input and the compiler must
+		// outlive the generator
+		[[nodiscard]] generator<parse_event> events(std::string_view input) const
+		{
+			auto scanner = tokenizer_.scan(string_input(input));
+
+			parse_session<Value> session;
+			session.actions_ = false;
+			session.reset();
+
+			event_sink sink(parse_table_);
+
+			while (true)
+			{
+				run_default_reductions(session, sink);
+
+				for (size_t i = 0; i < std::size(sink); ++i)
+					co_yield sink[i];
+
+				sink.clear();
+
+				const auto t = scanner.next();
+				const bool finished = push_token(session, t.id, t.lexeme, true, sink);
+
+				for (size_t i = 0; i < std::size(sink); ++i)
+					co_yield sink[i];
+
+				sink.clear();
+
+				if (finished)
+					co_return;
+			}
+		}
+
+	private:
+		// Trace of events(), mirrors the stack with the lexemes of its terminals and queues the steps of a call into the
+		// driver until the generator has yielded them
+		class event_sink
+		{
+			struct step
+			{
+				trace_event_kind kind;
+				size_t id;
+				std::string_view lexeme;
+				size_t first; // right-hand side of a reduce in reduced_
+				size_t length;
+			};
+
+			const parse_table* table_;
+			std::vector<token_view> symbols_;
+			std::vector<step> steps_;
+			std::vector<token_view> reduced_;
+
+		public:
+			explicit event_sink(const parse_table& table) noexcept
+				: table_(std::addressof(table)) {}
+
+		public:
+			void begin() noexcept {}
+
+			// Drops the steps yielded
+			void clear() noexcept
+			{
+				steps_.clear();
+				reduced_.clear();
+			}
+
+			void shift(const parse_session<Value>& session, size_t terminal)
+			{
+				const auto lexeme = session.symbols_[session.depth_ - 1].lexeme;
+
+				symbols_.push_back(token_view{ terminal, lexeme });
+				steps_.push_back(step{ trace_event_kind::shift, terminal, lexeme, 0, 0 });
+			}
+
+			void reduce(const parse_session<Value>&, size_t production)
+			{
+				const size_t length = table_->production_length(production);
+
+				steps_.push_back(step{ trace_event_kind::reduce, production, {}, std::size(reduced_), length });
+				reduced_.insert(std::end(reduced_), std::end(symbols_) - length, std::end(symbols_));
+
+				symbols_.resize(std::size(symbols_) - length);
+				symbols_.push_back(token_view{ table_->production_lhs(production), {} });
+			}
+
+			[[nodiscard]] size_t size() const noexcept
+			{
+				return std::size(steps_);
+			}
+
+			[[nodiscard]] parse_event operator[](size_t index) const noexcept
+			{
+				const auto& s = steps_[index];
+				return parse_event{ s.kind, s.id, s.lexeme, std::span<const token_view>(reduced_).subspan(s.first, s.length) };
+			}
+		};
+
+		template<class Input, class Trace>
+		[[nodiscard]] Value compile_input(Input input, parse_session<Value>& session, Trace& trace) const
+		{
+			auto scanner = tokenizer_.scan(std::move(input));
+
+			trace.begin();
+			session.reset();
+
+			while (true)
+			{
+				// The lookahead is only read once an action needs it, states with a default reduction reduce without it
+				run_default_reductions(session, trace);
+
+				// Lexemes of inputs that outlive the parse are only viewed, streamed ones are copied out of the window
+				const auto t = scanner.next();
+				if (push_token(session, t.id, t.lexeme, Input::stable, trace))
+					break;
+			}
+
+			return take_result(session);
+		}
+
+		// Reduces by the lookahead until it is shifted. Returns true if a reduce finished the parse instead, the
+		// lookahead is then the end of the input
+		template<class Trace>
+		bool push_token(parse_session<Value>& session, size_t id, std::string_view lexeme, bool stable, Trace& trace) const
+		{
+			const auto to = reduce_lookahead(session, id, trace);
+			if (to == parse_table::goto_npos)
+				return true;
+
+			shift(session, id, lexeme, stable, to);
+			trace.shift(session, id);
+			return false;
+		}
+
+		// Reduces by the lookahead until it is to be shifted and returns the state it goes to, goto_npos if a reduce
+		// or the accept finished the parse instead
+		template<class Trace>
+		[[nodiscard]] std::uint32_t reduce_lookahead(parse_session<Value>& session, size_t id, Trace& trace) const
+		{
+			const auto& table = parse_table_;
+
+			while (true)
+			{
+				const auto state = session.states_.back();
+
+				auto entry = table.default_reduction(state);
+				if (entry == parse_table::error_entry)
+					entry = table.action(state, id);
+
+				switch (parse_table::kind(entry))
 				{
-					const auto& action = std::get<parser_compiler::parser_compiler_result::state_data::action_shift>(r->second);
-
-					auto shifted_token = e0;
-					value_stack.push_back(lexer_tokens[std::size(lexer_tokens) - 2].value);
-					next_token();
-					reduction_stack.push_back(shifted_token);
-					auto new_state = parser[state_id].next().at(shifted_token);
-					reduction_stack.push_back(new_state);
-					modified = true;
-				}
-				else if (std::holds_alternative<parser_compiler::parser_compiler_result::state_data::action_reduce>(r->second))
+				case parse_table::action_kind::shift:
+					return static_cast<std::uint32_t>(parse_table::operand(entry));
+				case parse_table::action_kind::reduce:
 				{
-					const auto& action = std::get<parser_compiler::parser_compiler_result::state_data::action_reduce>(r->second);
+					const size_t production = parse_table::operand(entry);
+					const auto to = reduce_target(session, production);
 
-					// Get production
-					std::vector<std::size_t> production;
-					for (size_t i = 0; i < action.pop_count * 2; ++i)
-					{
-						if (i % 2 == 1)
-						{
-							production.push_back(reduction_stack.back());
-						}
+					// Reducing to a non-terminal the exposed state can't go to finishes the parse, at the end of the input
+					if (to == parse_table::goto_npos && id != token::end_token)
+						throw std::logic_error("Compilation error at token...");
 
-						reduction_stack.pop_back();
-					}
+					reduce(session, production, to, trace);
 
-					production = std::vector(std::rbegin(production), std::rend(production));
+					if (to == parse_table::goto_npos)
+						return parse_table::goto_npos;
 
-					// Get arguments for the action
-					std::vector<std::string> values;
-					for(std::size_t i = 0; i < action.pop_count; ++i)
-					{
-						values.push_back(value_stack.back());
-						value_stack.pop_back();
-					}
+					break;
+				}
+				case parse_table::action_kind::accept:
+					return parse_table::goto_npos;
+				default:
+					throw std::logic_error("Compilation error at token...");
+				}
+			}
+		}
 
-					values = std::vector(std::rbegin(values), std::rend(values));
+		// Pushes the terminal with its converted value and goes to the state. Lexemes of unstable inputs are copied
+		void shift(parse_session<Value>& session, size_t id, std::string_view lexeme, bool stable, std::uint32_t to) const
+		{
+			const size_t slot = session.push();
+			auto& symbol = session.symbols_[slot];
+			symbol.id = id;
 
-					std::size_t new_state = -1;
-					auto n = action.push_state;
+			if (stable)
+			{
+				symbol.lexeme = lexeme;
+				symbol.text.clear();
+			}
+			else
+			{
+				symbol.lexeme = {};
+				symbol.text.assign(lexeme);
+			}
 
-					state_id = reduction_stack.back();
-					reduction_stack.push_back(n);
-					bool is_done = (parser[state_id].next().contains(n) == false);
+			if (session.actions_)
+				convert_terminal(id, symbol.terminal(), session.values_[slot]);
 
-					if(is_done == false)
-						new_state = parser[state_id].next().at(n);
+			session.states_.push_back(to);
+		}
 
-					// Find the satisfied production
-					auto& nt = std::get<
-						parser_compiler::parser_compiler_result::non_terminal>(parser_.tokens[n]);
+		// Takes the default reductions of the states on top of the stack, except one finishing the parse, which has to
+		// see the end of the input first
+		template<class Trace>
+		void run_default_reductions(parse_session<Value>& session, Trace& trace) const
+		{
+			while (true)
+			{
+				const auto entry = parse_table_.default_reduction(session.states_.back());
+				if (entry == parse_table::error_entry)
+					return;
 
-					value_stack.emplace_back();
-					for (std::size_t j = 0; j < std::size(nt.productions); ++j)
-					{
-						if (nt.productions[j] == production)
-						{
-							const auto& action_name = nt.production_actions[j];
-							if (std::empty(action_name))
-								break;
+				const size_t production = parse_table::operand(entry);
+				const auto to = reduce_target(session, production);
 
-							try
-							{
-								value_stack.back() =
-									this->actions_.at(action_name)(values);
-							}
-							catch (const std::out_of_range&)
-							{
-								throw std::logic_error("Undefined action.");
-							}
+				if (to == parse_table::goto_npos)
+					return;
 
-							break;
-						}
-					}
+				reduce(session, production, to, trace);
+			}
+		}
 
-					if(is_done == false)
-					{
-						reduction_stack.push_back(new_state);
-					}
-					modified = ( is_done == false );	
-					
-				}
-				else if(std::holds_alternative<parser_compiler::parser_compiler_result::state_data::action_accept>(r->second))
+		// Flat buffers are copied into slots whose buffer fits them rather than moved, moving would free the buffer and
+		// the next parse would allocate it again
+		static void store(Value& slot, Value&& value)
+		{
+			if constexpr (flat_buffer<Value>)
+			{
+				if (std::size(value) <= slot.capacity())
 				{
-					modified = false;
+					slot = value;
+					return;
 				}
-				else
+			}
+
+			slot = std::move(value);
+		}
+
+		// Value of a finished parse, copied out when the slot's buffer is worth keeping
+		[[nodiscard]] static Value take_result(parse_session<Value>& session)
+		{
+			auto& result = session.values_[session.depth_ - 1];
+
+			if constexpr (flat_buffer<Value>)
+				return result;
+			else
+				return std::move(result);
+		}
+
+		// State the reduce goes to, goto_npos if it finishes the parse
+		[[nodiscard]] std::uint32_t reduce_target(const parse_session<Value>& session, size_t production) const noexcept
+		{
+			const auto exposed = session.states_[std::size(session.states_) - 1 - parse_table_.production_length(production)];
+			return parse_table_.go_to(exposed, parse_table_.production_lhs(production));
+		}
+
+		// Replaces the right-hand side of the production on top of the stacks with its value, actions read the values
+		// in place and their result is moved into the slot of the first one
+		template<class Trace>
+		void reduce(parse_session<Value>& session, size_t production, std::uint32_t to, Trace& trace) const
+		{
+			const auto& table = parse_table_;
+			const size_t length = table.production_length(production);
+
+			Value result{};
+			if (const auto slot = table.action_slot(production); slot != parse_table::no_action && session.actions_)
+			{
+				const auto& bound = bound_actions_[slot];
+
+				if (const auto* f = std::get_if<action>(&bound))
 				{
-					assert(false);
+					result = (*f)(session.top(length));
 				}
+				else if (const auto* va = std::get_if<view_action>(&bound))
+				{
+					session.views_.clear();
+					for (size_t i = session.depth_ - length; i < session.depth_; ++i)
+					{
+						const auto& symbol = session.symbols_[i];
+						session.views_.push_back(token_view{ symbol.id, symbol.id < table.terminal_count() ? symbol.terminal() : value_view(session.values_[i]) });
+					}
 
-				for (std::size_t i = 0; i < reduction_stack.size(); ++i)
+					result = (*va)(session.views_);
+				}
+				else
 				{
-					if(i % 2 == 0)
-						os << reduction_stack[i] << ' ';
-					else
-						os << "[" << reduction_stack[i] << "] ";
+					throw std::logic_error("Undefined action.");
 				}
-				os << '\n';
 			}
 
-			return value_stack.back();
+			// Traces that keep the values take them before the result overwrites the first
+			if constexpr (requires { trace.pop(std::as_const(session), production); })
+				trace.pop(session, production);
+
+			session.states_.resize(std::size(session.states_) - length);
+			session.depth_ -= length;
+
+			const size_t slot = session.push();
+			store(session.values_[slot], std::move(result));
+			session.symbols_[slot].id = table.production_lhs(production);
+
+			if (to != parse_table::goto_npos)
+				session.states_.push_back(to);
+
+			trace.reduce(session, production);
 		}
 	};
+
+	using compiler = basic_compiler<std::string>;
 }
\ No newline at end of file
@@ -1,7 +1,7 @@
 #include <lex_compiler/lex_compiler.hpp>
 #include <regex_compiler/regex_compiler.hpp>
 
-fox_cc::lex_compiler::lex_compiler(const prs::yacc_ast& ast)
+fox_cc::lex_compiler::lex_compiler(const prs::yacc_ast& ast, bool minimize)
 	: ast_(ast)
 {
 	this->result_.terminals.emplace_back(
@@ -94,4 +94,41 @@ fox_cc::lex_compiler::lex_compiler(const prs::yacc_ast& ast)
 		reduce_conflict_resolver,
 		merge_conflict_resolver
 	);
+
+	this->result_.dfa_states = std::size(this->result_.dfa);
+
+	if (minimize)
+	{
+		this->result_.dfa = automata::minimize_dfa(this->result_.dfa);
+	}
+
+	this->result_.minimized_dfa_states = std::size(this->result_.dfa);
+
+	// Compute character classes, every DFA edge is a union of whole classes
+	{
+		std::vector<charset> edges;
+		for (const auto& state : this->result_.dfa)
+		{
+			for (const auto& edge : state.next() | std::views::keys)
+				edges.push_back(edge);
+		}
+
+		auto& classes = this->result_.char_classes;
+		classes = automata::edge_traits<charset>::unique_edges(edges);
+
+		charset unused = charset{}.flip();
+		for (const auto& c : classes)
+			unused &= ~c;
+
+		classes.insert(std::begin(classes), unused);
+
+		for (size_t i = 0; i < std::size(classes); ++i)
+		{
+			for (size_t c = 0; c < std::size(classes[i]); ++c)
+			{
+				if (classes[i].test(c))
+					this->result_.char_class_map[c] = static_cast<std::uint8_t>(i);
+			}
+		}
+	}
 }
@@ -2,7 +2,9 @@
 
 #include <internal_parser/yacc_ast.hpp>
 
+#include <array>
 #include <bitset>
+#include <cstdint>
 #include <map>
 #include <automata/dfa.hpp>
 
@@ -32,6 +34,13 @@ namespace fox_cc
 
 			std::vector<lex_token> terminals; // maps IDs to terminals
 			automata::dfa<automata::empty_state, size_t, charset> dfa;
+
+			size_t dfa_states = 0; // state count of the subset construction
+			size_t minimized_dfa_states = 0; // state count after minimization, equals dfa_states if it was skipped
+
+			// Partition of the alphabet into characters the DFA never tells apart, class 0 holds characters no edge accepts
+			std::vector<charset> char_classes;
+			std::array<std::uint8_t, 128> char_class_map = {}; // maps characters to classes
 		};
 
 	private:
@@ -46,7 +55,7 @@ namespace fox_cc
 		lex_compiler& operator=(lex_compiler&&) noexcept = delete;
 
 	public:
-		lex_compiler(const prs::yacc_ast& ast);
+		lex_compiler(const prs::yacc_ast& ast, bool minimize = true);
 
 		~lex_compiler() noexcept = default;
 
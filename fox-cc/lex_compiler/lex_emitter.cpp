@@ -0,0 +1,129 @@
+#include <lex_compiler/lex_emitter.hpp>
+
+#include <sstream>
+#include <stdexcept>
+#include <cctype>
+
+namespace
+{
+	void emit_case_label(std::ostream& os, size_t c)
+	{
+		if (std::isalnum(static_cast<int>(c)))
+			os << "case '" << static_cast<char>(c) << "':";
+		else
+			os << "case " << c << ":";
+	}
+}
+
+void fox_cc::emit_string_literal(std::ostream& os, std::string_view str)
+{
+	os << '"';
+	for (const char c : str)
+	{
+		if (c == '"' || c == '\\')
+			os << '\\' << c;
+		else if (std::isprint(static_cast<unsigned char>(c)))
+			os << c;
+		else
+			os << "\\x" << std::hex << static_cast<unsigned>(static_cast<unsigned char>(c)) << std::dec << "\"\"";
+	}
+	os << '"';
+}
+
+std::string fox_cc::emit_lexer_cpp(const lex_compiler::lex_compiler_result& lex_result, std::string_view name_space)
+{
+	const auto& dfa = lex_result.dfa;
+
+	if (dfa.size() == 0)
+		throw std::logic_error("The lexer DFA isn't available, the grammar was loaded without running the generator.");
+
+	std::stringstream ss;
+
+	ss << "// Generated by fox-cc, do not edit\n";
+	ss << "#pragma once\n\n";
+	ss << "#include <cstddef>\n";
+	ss << "#include <string_view>\n\n";
+	ss << "namespace " << name_space << "\n{\n";
+
+	ss << "\tinline constexpr std::size_t token_npos = static_cast<std::size_t>(-1);\n";
+	ss << "\tinline constexpr std::size_t end_token = 0;\n\n";
+
+	ss << "\tinline constexpr std::string_view token_names[] = {\n";
+	for (const auto& terminal : lex_result.terminals)
+	{
+		ss << "\t\t";
+		emit_string_literal(ss, terminal.name);
+		ss << ",\n";
+	}
+	ss << "\t};\n\n";
+
+	ss << "\tstruct match\n\t{\n";
+	ss << "\t\tstd::size_t token;\n";
+	ss << "\t\tstd::size_t length;\n";
+	ss << "\t};\n\n";
+
+	ss << "\t// Longest token at the start of the input, {end_token, 0} for an empty input, {token_npos, 0} if no token matches\n";
+	ss << "\tinline match next_token(std::string_view input) noexcept\n\t{\n";
+	ss << "\t\tif (input.empty())\n";
+	ss << "\t\t\treturn { end_token, 0 };\n\n";
+	ss << "\t\tconst char* const begin = input.data();\n";
+	ss << "\t\tconst char* const end = begin + input.size();\n";
+	ss << "\t\tconst char* p = begin;\n";
+	ss << "\t\tstd::size_t token = token_npos;\n";
+	ss << "\t\tconst char* accept = begin;\n\n";
+	ss << "\t\tgoto s" << dfa.start() << ";\n\n";
+
+	for (size_t i = 0; i < std::size(dfa); ++i)
+	{
+		const auto& state = dfa[i];
+
+		ss << "\ts" << i << ":\n";
+
+		if (state.reduce())
+			ss << "\t\ttoken = " << state.reduce().value() << ";\n\t\taccept = p;\n";
+
+		if (std::empty(state.next()))
+		{
+			ss << "\t\tgoto done;\n\n";
+			continue;
+		}
+
+		ss << "\t\tif (p == end)\n\t\t\tgoto done;\n";
+		ss << "\t\tswitch (static_cast<unsigned char>(*p++))\n\t\t{\n";
+
+		// Edges of a DFA never intersect, every character is labeled at most once
+		for (const auto& [edge, to] : state.next())
+		{
+			size_t on_line = 0;
+			for (size_t c = 0; c < std::size(edge); ++c)
+			{
+				if (!edge.test(c))
+					continue;
+
+				ss << (on_line == 0 ? "\t\t" : " ");
+				emit_case_label(ss, c);
+
+				if (++on_line == 8)
+				{
+					ss << '\n';
+					on_line = 0;
+				}
+			}
+
+			if (on_line != 0)
+				ss << '\n';
+
+			ss << "\t\t\tgoto s" << to << ";\n";
+		}
+
+		ss << "\t\tdefault:\n\t\t\tgoto done;\n";
+		ss << "\t\t}\n\n";
+	}
+
+	ss << "\tdone:\n";
+	ss << "\t\treturn { token, token == token_npos ? 0 : static_cast<std::size_t>(accept - begin) };\n";
+	ss << "\t}\n";
+	ss << "}\n";
+
+	return ss.str();
+}
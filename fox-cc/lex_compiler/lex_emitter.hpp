@@ -0,0 +1,19 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <ostream>
+
+#include <lex_compiler/lex_compiler.hpp>
+
+namespace fox_cc
+{
+	// Emits a standalone C++ header with a direct-coded scanner for the lexer DFA, one label per state and a switch
+	// over the next byte. The generated next_token(std::string_view) returns the longest token at the start of the
+	// input, ids match the terminals of the lex_compiler_result. Throws std::logic_error if the result has no DFA.
+	[[nodiscard]] std::string emit_lexer_cpp(const lex_compiler::lex_compiler_result& lex_result, std::string_view name_space);
+
+	// Writes str as a C++ string literal, non-printable bytes as hex escapes closed by an empty literal so the next
+	// character isn't read as part of the escape
+	void emit_string_literal(std::ostream& os, std::string_view str);
+}
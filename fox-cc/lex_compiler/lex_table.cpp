@@ -0,0 +1,140 @@
+#include <lex_compiler/lex_table.hpp>
+
+namespace
+{
+	struct owned_storage
+	{
+		std::array<std::uint8_t, fox_cc::lex_table::alphabet_size> classes = {};
+		std::vector<std::uint16_t> transitions16;
+		std::vector<std::uint32_t> transitions32;
+		std::vector<fox_cc::lex_table::token_id> accept;
+	};
+}
+
+fox_cc::lex_table::lex_table(const lex_compiler::lex_compiler_result& lex_result)
+{
+	const auto& dfa = lex_result.dfa;
+	auto storage = std::make_shared<owned_storage>();
+
+	start_ = dfa.start();
+	size_ = std::size(dfa);
+	class_count_ = std::size(lex_result.char_classes);
+	storage->accept.assign(std::size(dfa), token_npos);
+
+	// Bytes outside of the charset fall into class 0, which no edge accepts
+	for (size_t c = 0; c < std::size(lex_result.char_class_map); ++c)
+		storage->classes[c] = lex_result.char_class_map[c];
+
+	auto fill = [&]<class StateId>(std::vector<StateId>& transitions)
+	{
+		transitions.assign(std::size(dfa) * class_count_, std::numeric_limits<StateId>::max());
+
+		for (size_t i = 0; i < std::size(dfa); ++i)
+		{
+			const auto& state = dfa[i];
+
+			if (state.reduce())
+				storage->accept[i] = static_cast<token_id>(state.reduce().value());
+
+			// Edges of a DFA never intersect, so every class is written at most once
+			for (const auto& [edge, to] : state.next())
+			{
+				for (size_t j = 0; j < class_count_; ++j)
+				{
+					if ((lex_result.char_classes[j] & edge).any())
+						transitions[i * class_count_ + j] = static_cast<StateId>(to);
+				}
+			}
+		}
+
+		state_width_ = sizeof(StateId);
+		transitions_ = std::data(transitions);
+	};
+
+	// Max value of the state id is reserved for the missing transition
+	if (std::size(dfa) < std::numeric_limits<std::uint16_t>::max())
+		fill(storage->transitions16);
+	else
+		fill(storage->transitions32);
+
+	classes_ = std::data(storage->classes);
+	accept_ = std::data(storage->accept);
+	storage_ = std::move(storage);
+}
+
+void fox_cc::lex_table::save(binary_writer& out) const
+{
+	out.write(static_cast<std::uint64_t>(start_));
+	out.write(static_cast<std::uint64_t>(size_));
+	out.write(static_cast<std::uint64_t>(class_count_));
+	out.write(static_cast<std::uint64_t>(state_width_));
+
+	out.write_array(std::span(classes_, alphabet_size));
+
+	visit([&](const auto& v)
+	{
+		out.write_array(std::span(v.transitions, size_ * class_count_));
+	});
+
+	out.write_array(std::span(accept_, size_));
+}
+
+fox_cc::lex_table fox_cc::lex_table::load(binary_reader& in, table_storage storage)
+{
+	lex_table out;
+
+	out.start_ = static_cast<state_id>(in.read<std::uint64_t>());
+	out.size_ = static_cast<size_t>(in.read<std::uint64_t>());
+	out.class_count_ = static_cast<size_t>(in.read<std::uint64_t>());
+	out.state_width_ = static_cast<size_t>(in.read<std::uint64_t>());
+
+	if (out.state_width_ != sizeof(std::uint16_t) && out.state_width_ != sizeof(std::uint32_t))
+		throw std::runtime_error("Invalid lexer table.");
+
+	const auto classes = in.read_array<std::uint8_t>();
+
+	size_t transition_count = 0;
+	auto read_transitions = [&]<class StateId>()
+	{
+		const auto transitions = in.read_array<StateId>();
+		transition_count = std::size(transitions);
+		out.transitions_ = std::data(transitions);
+
+		for (const auto to : transitions)
+		{
+			if (to != std::numeric_limits<StateId>::max() && to >= out.size_)
+				throw std::runtime_error("Invalid lexer table.");
+		}
+	};
+
+	if (out.state_width_ == sizeof(std::uint16_t))
+		read_transitions.operator()<std::uint16_t>();
+	else
+		read_transitions.operator()<std::uint32_t>();
+
+	const auto accept = in.read_array<token_id>();
+
+	if (
+		std::size(classes) != alphabet_size ||
+		transition_count != out.size_ * out.class_count_ ||
+		std::size(accept) != out.size_ ||
+		out.start_ >= out.size_
+		)
+	{
+		throw std::runtime_error("Invalid lexer table.");
+	}
+
+	for (const auto c : classes)
+	{
+		if (c >= out.class_count_)
+			throw std::runtime_error("Invalid lexer table.");
+	}
+
+	// Token ids are checked against the terminals by load_grammar
+
+	out.classes_ = std::data(classes);
+	out.accept_ = std::data(accept);
+	out.storage_ = std::move(storage);
+
+	return out;
+}
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <memory>
+#include <limits>
+#include <cstdint>
+#include <cassert>
+
+#include <lex_compiler/lex_compiler.hpp>
+#include <runtime/binary_io.hpp>
+
+namespace fox_cc
+{
+	// Frozen representation of the lexer DFA used by the runtime, one indexed load per input byte.
+	// Transitions are indexed by character class and use the narrowest state id that fits the DFA.
+	class lex_table
+	{
+	public:
+		using state_id = size_t;
+		using token_id = std::uint32_t;
+
+		static inline constexpr state_id state_npos = std::numeric_limits<state_id>::max();
+		static inline constexpr token_id token_npos = std::numeric_limits<token_id>::max();
+		static inline constexpr size_t alphabet_size = 256;
+
+		template<class StateId>
+		struct view
+		{
+			using state_type = StateId;
+
+			static inline constexpr StateId state_npos = std::numeric_limits<StateId>::max();
+
+			const std::uint8_t* classes;
+			const StateId* transitions;
+			const token_id* accept_tokens;
+			size_t class_count;
+
+			[[nodiscard]] StateId next(StateId state, unsigned char c) const noexcept
+			{
+				return transitions[state * class_count + classes[c]];
+			}
+
+			[[nodiscard]] token_id accept(StateId state) const noexcept
+			{
+				return accept_tokens[state];
+			}
+		};
+
+	private:
+		state_id start_ = state_npos;
+		size_t size_ = 0;
+		size_t class_count_ = 0;
+		size_t state_width_ = sizeof(std::uint16_t);
+
+		table_storage storage_; // owns the arrays below
+		const std::uint8_t* classes_ = nullptr; // [byte] -> character class
+		const void* transitions_ = nullptr; // [state][class] -> state, std::uint16_t or std::uint32_t by state_width_
+		const token_id* accept_ = nullptr; // [state] -> token, token_npos if state doesn't accept
+
+	public:
+		lex_table() = default;
+		lex_table(const lex_table&) = default;
+		lex_table(lex_table&&) noexcept = default;
+		lex_table& operator=(const lex_table&) = default;
+		lex_table& operator=(lex_table&&) noexcept = default;
+		~lex_table() noexcept = default;
+
+	public:
+		explicit lex_table(const lex_compiler::lex_compiler_result& lex_result);
+
+	public:
+		void save(binary_writer& out) const;
+
+		[[nodiscard]] static lex_table load(binary_reader& in, table_storage storage);
+
+	public:
+		[[nodiscard]] size_t size() const noexcept
+		{
+			return size_;
+		}
+
+		[[nodiscard]] size_t class_count() const noexcept
+		{
+			return class_count_;
+		}
+
+		[[nodiscard]] size_t state_width() const noexcept
+		{
+			return state_width_;
+		}
+
+		[[nodiscard]] state_id start() const noexcept
+		{
+			return start_;
+		}
+
+		// Calls f with a view<std::uint16_t> or view<std::uint32_t>, depending on the table's state width
+		template<class F>
+		decltype(auto) visit(F&& f) const
+		{
+			if (state_width_ == sizeof(std::uint16_t))
+				return f(make_view<std::uint16_t>());
+
+			return f(make_view<std::uint32_t>());
+		}
+
+		[[nodiscard]] state_id next(state_id state, unsigned char c) const noexcept
+		{
+			assert(state < size());
+
+			return visit([=](const auto& v) -> state_id
+			{
+				const auto r = v.next(static_cast<typename std::decay_t<decltype(v)>::state_type>(state), c);
+				return r == v.state_npos ? state_npos : r;
+			});
+		}
+
+		[[nodiscard]] token_id accept(state_id state) const noexcept
+		{
+			assert(state < size());
+			return accept_[state];
+		}
+
+	private:
+		template<class StateId>
+		[[nodiscard]] view<StateId> make_view() const noexcept
+		{
+			return view<StateId>{
+				classes_,
+				static_cast<const StateId*>(transitions_),
+				accept_,
+				class_count_
+			};
+		}
+	};
+}
@@ -0,0 +1,736 @@
+#include <parser_compiler/parse_table.hpp>
+#include <lex_compiler/lex_emitter.hpp>
+
+#include <sstream>
+#include <stdexcept>
+#include <algorithm>
+#include <unordered_map>
+
+namespace fox_cc
+{
+	// Owns the arrays of tables that weren't loaded from a file and lays them out
+	struct parse_table_builder
+	{
+		using entry = parse_table::entry;
+
+		struct storage
+		{
+			std::vector<entry> actions;
+			std::vector<std::uint32_t> gotos;
+			std::vector<entry> default_reductions;
+
+			std::vector<entry> default_actions;
+			std::vector<std::uint32_t> action_base;
+			std::vector<std::uint32_t> action_check;
+			std::vector<entry> action_entries;
+			std::vector<std::uint32_t> default_gotos;
+			std::vector<std::uint32_t> goto_base;
+			std::vector<std::uint32_t> goto_check;
+			std::vector<std::uint32_t> goto_entries;
+
+			std::vector<std::uint32_t> production_lhs;
+			std::vector<std::uint32_t> production_length;
+			std::vector<std::uint32_t> production_offsets;
+			std::vector<std::uint32_t> production_symbols;
+			std::vector<std::uint32_t> production_action_slots;
+		};
+
+		// Row displacement, rows with the most entries are placed first at the lowest base where none of their
+		// columns collide. Rows are [row] -> (column, value) pairs, width is the number of columns
+		template<class T>
+		static void pack(
+			const std::vector<std::vector<std::pair<size_t, T>>>& rows, size_t width,
+			std::vector<std::uint32_t>& base, std::vector<std::uint32_t>& check, std::vector<T>& entries)
+		{
+			std::vector<size_t> order(std::size(rows));
+			for (size_t i = 0; i < std::size(order); ++i)
+				order[i] = i;
+
+			std::ranges::stable_sort(order, std::greater<>{}, [&](size_t i) { return std::size(rows[i]); });
+
+			base.assign(std::size(rows), 0);
+			check.clear();
+			entries.clear();
+
+			size_t first_free = 0; // every slot below it is taken
+			size_t end = width; // padding so base + column stays in bounds for every row
+
+			for (const size_t row : order)
+			{
+				const auto& cells = rows[row];
+				if (std::empty(cells))
+					continue;
+
+				size_t b = first_free > cells.front().first ? first_free - cells.front().first : 0;
+				for (; ; ++b)
+				{
+					const bool fits = std::ranges::all_of(cells, [&](const auto& cell)
+					{
+						return b + cell.first >= std::size(check) || check[b + cell.first] == parse_table::check_npos;
+					});
+
+					if (fits)
+						break;
+				}
+
+				const size_t needed = b + width;
+				if (std::size(check) < needed)
+				{
+					check.resize(needed, parse_table::check_npos);
+					entries.resize(needed, T{});
+				}
+
+				for (const auto& [column, value] : cells)
+				{
+					check[b + column] = static_cast<std::uint32_t>(row);
+					entries[b + column] = value;
+				}
+
+				base[row] = static_cast<std::uint32_t>(b);
+				end = std::max(end, needed);
+
+				while (first_free < std::size(check) && check[first_free] != parse_table::check_npos)
+					++first_free;
+			}
+
+			check.resize(end, parse_table::check_npos);
+			entries.resize(end, T{});
+		}
+
+		// A state whose only action is a single reduce takes it whatever the lookahead is, errors included, the
+		// error surfaces in the state the reduce leads to
+		static void find_default_reductions(storage& out, size_t state_count, size_t terminal_count)
+		{
+			out.default_reductions.assign(state_count, parse_table::error_entry);
+
+			for (size_t s = 0; s < state_count; ++s)
+			{
+				const auto row = std::span(out.actions).subspan(s * terminal_count, terminal_count);
+
+				entry reduce = parse_table::error_entry;
+				for (const auto e : row)
+				{
+					if (e == parse_table::error_entry || e == reduce)
+						continue;
+
+					if (reduce != parse_table::error_entry || parse_table::kind(e) != parse_table::action_kind::reduce)
+					{
+						reduce = parse_table::error_entry;
+						break;
+					}
+
+					reduce = e;
+				}
+
+				out.default_reductions[s] = reduce;
+			}
+		}
+
+		static void compress(storage& out, size_t state_count, size_t terminal_count, size_t non_terminal_count)
+		{
+			// Rows of ACTION default to their most common reduce, which also covers the row's errors
+			std::vector<std::vector<std::pair<size_t, entry>>> action_rows(state_count);
+			out.default_actions.assign(state_count, parse_table::error_entry);
+
+			for (size_t s = 0; s < state_count; ++s)
+			{
+				const auto row = std::span(out.actions).subspan(s * terminal_count, terminal_count);
+
+				std::unordered_map<entry, size_t> reduces;
+				for (const auto e : row)
+				{
+					if (parse_table::kind(e) == parse_table::action_kind::reduce)
+						++reduces[e];
+				}
+
+				auto& d = out.default_actions[s];
+				size_t best = 0;
+				for (const auto& [e, count] : reduces)
+				{
+					if (count > best || (count == best && e < d))
+					{
+						d = e;
+						best = count;
+					}
+				}
+
+				for (size_t t = 0; t < terminal_count; ++t)
+				{
+					if (row[t] != parse_table::error_entry && row[t] != d)
+						action_rows[s].emplace_back(t, row[t]);
+				}
+			}
+
+			pack(action_rows, terminal_count, out.action_base, out.action_check, out.action_entries);
+
+			// Columns of GOTO default to their most common target. A missing goto is only ever read from the start
+			// state, where it finishes the parse, so the start state keeps its missing gotos
+			std::vector<std::vector<std::pair<size_t, std::uint32_t>>> goto_columns(non_terminal_count);
+			out.default_gotos.assign(non_terminal_count, parse_table::goto_npos);
+
+			for (size_t nt = 0; nt < non_terminal_count; ++nt)
+			{
+				std::unordered_map<std::uint32_t, size_t> targets;
+				for (size_t s = 0; s < state_count; ++s)
+				{
+					const auto g = out.gotos[s * non_terminal_count + nt];
+					if (g != parse_table::goto_npos)
+						++targets[g];
+				}
+
+				auto& d = out.default_gotos[nt];
+				size_t best = 0;
+				for (const auto& [g, count] : targets)
+				{
+					if (count > best || (count == best && g < d))
+					{
+						d = g;
+						best = count;
+					}
+				}
+
+				for (size_t s = 0; s < state_count; ++s)
+				{
+					const auto g = out.gotos[s * non_terminal_count + nt];
+					if (g != d && (g != parse_table::goto_npos || s == 0))
+						goto_columns[nt].emplace_back(s, g);
+				}
+			}
+
+			pack(goto_columns, state_count, out.goto_base, out.goto_check, out.goto_entries);
+
+			out.actions.clear();
+			out.actions.shrink_to_fit();
+			out.gotos.clear();
+			out.gotos.shrink_to_fit();
+		}
+
+		// Lays out the dense tables in out and points the table at them
+		static void assign(parse_table& table, std::shared_ptr<storage> out, parse_table_layout layout)
+		{
+			table.layout_ = layout;
+			table.production_count_ = std::size(out->production_lhs);
+
+			find_default_reductions(*out, table.state_count_, table.terminal_count_);
+			table.default_reductions_ = std::data(out->default_reductions);
+
+			if (layout == parse_table_layout::compressed)
+			{
+				compress(*out, table.state_count_, table.terminal_count_, table.non_terminal_count_);
+
+				table.actions_ = nullptr;
+				table.gotos_ = nullptr;
+				table.compressed_ = parse_table::compressed_tables{
+					std::data(out->default_actions),
+					std::data(out->action_base),
+					std::data(out->action_check),
+					std::data(out->action_entries),
+					std::size(out->action_check),
+					std::data(out->default_gotos),
+					std::data(out->goto_base),
+					std::data(out->goto_check),
+					std::data(out->goto_entries),
+					std::size(out->goto_check)
+				};
+			}
+			else
+			{
+				table.actions_ = std::data(out->actions);
+				table.gotos_ = std::data(out->gotos);
+				table.compressed_ = {};
+			}
+
+			table.production_lhs_ = std::data(out->production_lhs);
+			table.production_length_ = std::data(out->production_length);
+			table.production_offsets_ = std::data(out->production_offsets);
+			table.production_symbols_ = std::data(out->production_symbols);
+			table.production_action_slots_ = std::data(out->production_action_slots);
+			table.storage_ = std::move(out);
+		}
+	};
+}
+
+fox_cc::parse_table::parse_table(const parser_compiler::parser_compiler_result& parser_result, parse_table_layout layout)
+{
+	using state_data = parser_compiler::parser_compiler_result::state_data;
+
+	const auto& tokens = parser_result.tokens;
+	const auto& dfa = parser_result.dfa;
+	auto storage = std::make_shared<parse_table_builder::storage>();
+
+	while (terminal_count_ < std::size(tokens) && tokens[terminal_count_].is_terminal())
+		++terminal_count_;
+
+	state_count_ = std::size(dfa);
+	non_terminal_count_ = std::size(tokens) - terminal_count_;
+
+	if (state_count_ >= (size_t(1) << (32 - kind_bits)))
+		throw std::length_error("Parser has too many states for the parse table.");
+
+	for (const auto& token : tokens)
+		symbol_names_.push_back(token.name());
+
+	action_names_ = parser_result.actions;
+
+	// Productions are laid out in their global order, the one reduces refer to
+	for (size_t i = terminal_count_; i < std::size(tokens); ++i)
+	{
+		const auto& nt = tokens[i].non_terminal();
+		assert(nt.first_production == std::size(storage->production_lhs));
+
+		for (size_t j = 0; j < std::size(nt.productions); ++j)
+		{
+			const auto slot = nt.action_slots[j];
+
+			storage->production_lhs.push_back(static_cast<std::uint32_t>(i));
+			storage->production_length.push_back(static_cast<std::uint32_t>(std::size(nt.productions[j])));
+			storage->production_action_slots.push_back(slot == parser_compiler::parser_compiler_result::action_npos ? no_action : static_cast<std::uint32_t>(slot));
+			production_actions_.push_back(nt.production_actions[j]);
+
+			storage->production_offsets.push_back(static_cast<std::uint32_t>(std::size(storage->production_symbols)));
+			for (const auto symbol : nt.productions[j])
+				storage->production_symbols.push_back(static_cast<std::uint32_t>(symbol));
+		}
+	}
+
+	storage->production_offsets.push_back(static_cast<std::uint32_t>(std::size(storage->production_symbols)));
+
+	auto& actions = storage->actions;
+	auto& gotos = storage->gotos;
+	actions.assign(state_count_ * terminal_count_, error_entry);
+	gotos.assign(state_count_ * non_terminal_count_, goto_npos);
+
+	for (size_t s = 0; s < state_count_; ++s)
+	{
+		const auto& state = dfa[s];
+
+		for (const auto& [token, to] : state.next())
+		{
+			if (token >= terminal_count_)
+				gotos[s * non_terminal_count_ + (token - terminal_count_)] = static_cast<std::uint32_t>(to);
+		}
+
+		for (const auto& [token, action] : state.value().action_table)
+		{
+			// Shifts of non-terminals are already in the GOTO table
+			if (token >= terminal_count_)
+				continue;
+
+			auto& out = actions[s * terminal_count_ + token];
+
+			if (const auto* shift = std::get_if<state_data::action_shift>(&action))
+			{
+				out = make_entry(action_kind::shift, shift->goto_state);
+			}
+			else if (const auto* reduce = std::get_if<state_data::action_reduce>(&action))
+			{
+				out = make_entry(action_kind::reduce, reduce->production);
+			}
+			else
+			{
+				out = make_entry(action_kind::accept, 0);
+			}
+		}
+	}
+
+	parse_table_builder::assign(*this, std::move(storage), layout);
+}
+
+fox_cc::parse_table fox_cc::parse_table::with_layout(parse_table_layout layout) const
+{
+	auto storage = std::make_shared<parse_table_builder::storage>();
+
+	storage->actions.resize(state_count_ * terminal_count_);
+	for (size_t s = 0; s < state_count_; ++s)
+	{
+		for (size_t t = 0; t < terminal_count_; ++t)
+			storage->actions[s * terminal_count_ + t] = action(s, t);
+	}
+
+	storage->gotos.resize(state_count_ * non_terminal_count_);
+	for (size_t s = 0; s < state_count_; ++s)
+	{
+		for (size_t nt = 0; nt < non_terminal_count_; ++nt)
+			storage->gotos[s * non_terminal_count_ + nt] = go_to(s, terminal_count_ + nt);
+	}
+
+	storage->production_lhs.assign(production_lhs_, production_lhs_ + production_count_);
+	storage->production_length.assign(production_length_, production_length_ + production_count_);
+	storage->production_offsets.assign(production_offsets_, production_offsets_ + production_count_ + 1);
+	storage->production_symbols.assign(production_symbols_, production_symbols_ + production_offsets_[production_count_]);
+	storage->production_action_slots.assign(production_action_slots_, production_action_slots_ + production_count_);
+
+	parse_table out;
+	out.state_count_ = state_count_;
+	out.terminal_count_ = terminal_count_;
+	out.non_terminal_count_ = non_terminal_count_;
+	out.production_actions_ = production_actions_;
+	out.action_names_ = action_names_;
+	out.symbol_names_ = symbol_names_;
+
+	parse_table_builder::assign(out, std::move(storage), layout);
+	return out;
+}
+
+size_t fox_cc::parse_table::table_size() const noexcept
+{
+	if (layout_ == parse_table_layout::dense)
+		return (std::size(actions()) + std::size(gotos())) * sizeof(std::uint32_t);
+
+	return (
+		state_count_ * 2 + compressed_.action_size * 2 +
+		non_terminal_count_ * 2 + compressed_.goto_size * 2
+		) * sizeof(std::uint32_t);
+}
+
+void fox_cc::parse_table::save(binary_writer& out) const
+{
+	out.write(static_cast<std::uint32_t>(layout_));
+	out.write(static_cast<std::uint64_t>(state_count_));
+	out.write(static_cast<std::uint64_t>(terminal_count_));
+	out.write(static_cast<std::uint64_t>(non_terminal_count_));
+
+	if (layout_ == parse_table_layout::dense)
+	{
+		out.write_array(actions());
+		out.write_array(gotos());
+	}
+	else
+	{
+		const auto& c = compressed_;
+		out.write_array(std::span(c.default_actions, state_count_));
+		out.write_array(std::span(c.action_base, state_count_));
+		out.write_array(std::span(c.action_check, c.action_size));
+		out.write_array(std::span(c.action_entries, c.action_size));
+		out.write_array(std::span(c.default_gotos, non_terminal_count_));
+		out.write_array(std::span(c.goto_base, non_terminal_count_));
+		out.write_array(std::span(c.goto_check, c.goto_size));
+		out.write_array(std::span(c.goto_entries, c.goto_size));
+	}
+
+	out.write_array(default_reductions());
+	out.write_array(production_lhs());
+	out.write_array(production_length());
+	out.write_array(std::span(production_offsets_, production_count_ + 1));
+	out.write_array(std::span(production_symbols_, production_offsets_[production_count_]));
+	out.write_array(production_action_slots());
+
+	out.write(static_cast<std::uint64_t>(std::size(action_names_)));
+	for (const auto& action : action_names_)
+		out.write_string(action);
+
+	for (const auto& name : symbol_names_)
+		out.write_string(name);
+}
+
+fox_cc::parse_table fox_cc::parse_table::load(binary_reader& in, table_storage storage)
+{
+	parse_table out;
+
+	out.layout_ = static_cast<parse_table_layout>(in.read<std::uint32_t>());
+	out.state_count_ = static_cast<size_t>(in.read<std::uint64_t>());
+	out.terminal_count_ = static_cast<size_t>(in.read<std::uint64_t>());
+	out.non_terminal_count_ = static_cast<size_t>(in.read<std::uint64_t>());
+
+	if (out.layout_ == parse_table_layout::dense)
+	{
+		const auto actions = in.read_array<entry>();
+		const auto gotos = in.read_array<std::uint32_t>();
+
+		if (
+			std::size(actions) != out.state_count_ * out.terminal_count_ ||
+			std::size(gotos) != out.state_count_ * out.non_terminal_count_
+			)
+		{
+			throw std::runtime_error("Invalid parse table.");
+		}
+
+		out.actions_ = std::data(actions);
+		out.gotos_ = std::data(gotos);
+	}
+	else if (out.layout_ == parse_table_layout::compressed)
+	{
+		const auto default_actions = in.read_array<entry>();
+		const auto action_base = in.read_array<std::uint32_t>();
+		const auto action_check = in.read_array<std::uint32_t>();
+		const auto action_entries = in.read_array<entry>();
+		const auto default_gotos = in.read_array<std::uint32_t>();
+		const auto goto_base = in.read_array<std::uint32_t>();
+		const auto goto_check = in.read_array<std::uint32_t>();
+		const auto goto_entries = in.read_array<std::uint32_t>();
+
+		if (
+			std::size(default_actions) != out.state_count_ ||
+			std::size(action_base) != out.state_count_ ||
+			std::size(action_check) != std::size(action_entries) ||
+			std::size(default_gotos) != out.non_terminal_count_ ||
+			std::size(goto_base) != out.non_terminal_count_ ||
+			std::size(goto_check) != std::size(goto_entries)
+			)
+		{
+			throw std::runtime_error("Invalid parse table.");
+		}
+
+		// Bases are what keeps lookups in bounds
+		for (const auto b : action_base)
+		{
+			if (b + out.terminal_count_ > std::size(action_check))
+				throw std::runtime_error("Invalid parse table.");
+		}
+
+		for (const auto b : goto_base)
+		{
+			if (b + out.state_count_ > std::size(goto_check))
+				throw std::runtime_error("Invalid parse table.");
+		}
+
+		out.compressed_ = compressed_tables{
+			std::data(default_actions),
+			std::data(action_base),
+			std::data(action_check),
+			std::data(action_entries),
+			std::size(action_check),
+			std::data(default_gotos),
+			std::data(goto_base),
+			std::data(goto_check),
+			std::data(goto_entries),
+			std::size(goto_check)
+		};
+	}
+	else
+	{
+		throw std::runtime_error("Invalid parse table.");
+	}
+
+	const auto default_reductions = in.read_array<entry>();
+	if (std::size(default_reductions) != out.state_count_)
+		throw std::runtime_error("Invalid parse table.");
+
+	out.default_reductions_ = std::data(default_reductions);
+
+	const auto production_lhs = in.read_array<std::uint32_t>();
+	const auto production_length = in.read_array<std::uint32_t>();
+	const auto production_offsets = in.read_array<std::uint32_t>();
+	const auto production_symbols = in.read_array<std::uint32_t>();
+	const auto production_action_slots = in.read_array<std::uint32_t>();
+
+	out.production_count_ = std::size(production_lhs);
+
+	if (
+		std::size(production_length) != out.production_count_ ||
+		std::size(production_offsets) != out.production_count_ + 1 ||
+		std::size(production_action_slots) != out.production_count_ ||
+		production_offsets.back() != std::size(production_symbols)
+		)
+	{
+		throw std::runtime_error("Invalid parse table.");
+	}
+
+	const size_t symbol_count = out.terminal_count_ + out.non_terminal_count_;
+
+	for (size_t i = 0; i < out.production_count_; ++i)
+	{
+		if (
+			production_lhs[i] < out.terminal_count_ ||
+			production_lhs[i] >= symbol_count ||
+			production_offsets[i] > production_offsets[i + 1] ||
+			production_length[i] != production_offsets[i + 1] - production_offsets[i]
+			)
+		{
+			throw std::runtime_error("Invalid parse table.");
+		}
+	}
+
+	for (const auto symbol : production_symbols)
+	{
+		if (symbol >= symbol_count)
+			throw std::runtime_error("Invalid parse table.");
+	}
+
+	// Every target of the state tables is checked as well, a damaged file can't send the parser out of bounds
+	const auto check_entries = [&](std::span<const entry> entries, bool reduces_only)
+	{
+		for (const auto e : entries)
+		{
+			const auto k = kind(e);
+
+			if (
+				(k == action_kind::error && e != error_entry) ||
+				(k == action_kind::shift && (reduces_only || operand(e) >= out.state_count_)) ||
+				(k == action_kind::reduce && operand(e) >= out.production_count_) ||
+				(k == action_kind::accept && reduces_only)
+				)
+			{
+				throw std::runtime_error("Invalid parse table.");
+			}
+		}
+	};
+
+	const auto check_gotos = [&](std::span<const std::uint32_t> gotos)
+	{
+		for (const auto to : gotos)
+		{
+			if (to != goto_npos && to >= out.state_count_)
+				throw std::runtime_error("Invalid parse table.");
+		}
+	};
+
+	if (out.state_count_ == 0)
+		throw std::runtime_error("Invalid parse table.");
+
+	if (out.layout_ == parse_table_layout::dense)
+	{
+		check_entries(std::span(out.actions_, out.state_count_ * out.terminal_count_), false);
+		check_gotos(std::span(out.gotos_, out.state_count_ * out.non_terminal_count_));
+	}
+	else
+	{
+		const auto& c = out.compressed_;
+		check_entries(std::span(c.default_actions, out.state_count_), false);
+		check_entries(std::span(c.action_entries, c.action_size), false);
+		check_gotos(std::span(c.default_gotos, out.non_terminal_count_));
+		check_gotos(std::span(c.goto_entries, c.goto_size));
+	}
+
+	check_entries(default_reductions, true);
+
+	const auto action_count = in.read<std::uint64_t>();
+	for (std::uint64_t i = 0; i < action_count; ++i)
+		out.action_names_.emplace_back(in.read_string());
+
+	for (const auto slot : production_action_slots)
+	{
+		if (slot != no_action && slot >= std::size(out.action_names_))
+			throw std::runtime_error("Invalid parse table.");
+
+		out.production_actions_.emplace_back(slot == no_action ? std::string() : out.action_names_[slot]);
+	}
+
+	for (size_t i = 0; i < out.terminal_count_ + out.non_terminal_count_; ++i)
+		out.symbol_names_.emplace_back(in.read_string());
+
+	out.production_lhs_ = std::data(production_lhs);
+	out.production_length_ = std::data(production_length);
+	out.production_offsets_ = std::data(production_offsets);
+	out.production_symbols_ = std::data(production_symbols);
+	out.production_action_slots_ = std::data(production_action_slots);
+	out.storage_ = std::move(storage);
+
+	// In bounds targets can still pop below the bottom of the stack. Every stack in a state is at least as high as its
+	// shortest path from the start state, which is longer than the right-hand side of any reduce it takes
+	std::vector<size_t> depth(out.state_count_, std::numeric_limits<size_t>::max());
+	std::vector<size_t> queue{ 0 };
+	depth[0] = 1;
+
+	for (size_t i = 0; i < std::size(queue); ++i)
+	{
+		const size_t state = queue[i];
+
+		const auto visit = [&](size_t to)
+		{
+			if (depth[to] == std::numeric_limits<size_t>::max())
+			{
+				depth[to] = depth[state] + 1;
+				queue.push_back(to);
+			}
+		};
+
+		const auto check = [&](entry e)
+		{
+			if (kind(e) == action_kind::shift)
+				visit(operand(e));
+			else if (kind(e) == action_kind::reduce && out.production_length(operand(e)) >= depth[state])
+				throw std::runtime_error("Invalid parse table.");
+		};
+
+		check(out.default_reduction(state));
+
+		for (size_t t = 0; t < out.terminal_count_; ++t)
+			check(out.action(state, t));
+
+		for (size_t n = out.terminal_count_; n < symbol_count; ++n)
+		{
+			if (const auto to = out.go_to(state, n); to != goto_npos)
+				visit(to);
+		}
+	}
+
+	return out;
+}
+
+namespace
+{
+	template<class Range>
+	void emit_array(std::ostream& os, std::string_view type, std::string_view name, const Range& values, size_t per_line)
+	{
+		os << "\t\tstatic constexpr " << type << ' ' << name << "[] = {";
+
+		size_t i = 0;
+		for (const auto& v : values)
+		{
+			os << (i % per_line == 0 ? "\n\t\t\t" : " ");
+
+			if constexpr (std::is_convertible_v<decltype(v), std::string_view>)
+				fox_cc::emit_string_literal(os, v);
+			else
+				os << v;
+
+			os << ',';
+			++i;
+		}
+
+		os << "\n\t\t};\n\n";
+	}
+}
+
+std::string fox_cc::emit_parser_cpp(const parse_table& table, std::string_view name_space)
+{
+	std::stringstream ss;
+
+	ss << "// Generated by fox-cc, do not edit\n";
+	ss << "#pragma once\n\n";
+	ss << "#include <cstddef>\n";
+	ss << "#include <cstdint>\n";
+	ss << "#include <string_view>\n\n";
+	ss << "namespace " << name_space << "\n{\n";
+	ss << "\tstruct tables\n\t{\n";
+
+	ss << "\t\tstatic constexpr std::size_t state_count = " << table.state_count() << ";\n";
+	ss << "\t\tstatic constexpr std::size_t terminal_count = " << table.terminal_count() << ";\n";
+	ss << "\t\tstatic constexpr std::size_t non_terminal_count = " << table.non_terminal_count() << ";\n";
+	ss << "\t\tstatic constexpr std::size_t production_count = " << table.production_count() << ";\n\n";
+
+	ss << "\t\t// Entries are (operand << 2) | kind, kind is 0 error, 1 shift, 2 reduce, 3 accept\n";
+	if (table.layout() == parse_table_layout::dense)
+	{
+		ss << "\t\tstatic constexpr bool compressed = false;\n\n";
+		emit_array(ss, "std::uint32_t", "actions", table.actions(), std::max<size_t>(table.terminal_count(), 1));
+		emit_array(ss, "std::uint32_t", "gotos", table.gotos(), std::max<size_t>(table.non_terminal_count(), 1));
+	}
+	else
+	{
+		const auto& c = table.compressed();
+
+		ss << "\t\tstatic constexpr bool compressed = true;\n\n";
+		emit_array(ss, "std::uint32_t", "default_actions", std::span(c.default_actions, table.state_count()), 16);
+		emit_array(ss, "std::uint32_t", "action_base", std::span(c.action_base, table.state_count()), 16);
+		emit_array(ss, "std::uint32_t", "action_check", std::span(c.action_check, c.action_size), 16);
+		emit_array(ss, "std::uint32_t", "action_entries", std::span(c.action_entries, c.action_size), 16);
+		emit_array(ss, "std::uint32_t", "default_gotos", std::span(c.default_gotos, table.non_terminal_count()), 16);
+		emit_array(ss, "std::uint32_t", "goto_base", std::span(c.goto_base, table.non_terminal_count()), 16);
+		emit_array(ss, "std::uint32_t", "goto_check", std::span(c.goto_check, c.goto_size), 16);
+		emit_array(ss, "std::uint32_t", "goto_entries", std::span(c.goto_entries, c.goto_size), 16);
+	}
+
+	ss << "\t\t// Reduce taken without reading the lookahead, 0 if the state needs it\n";
+	emit_array(ss, "std::uint32_t", "default_reductions", table.default_reductions(), 16);
+	emit_array(ss, "std::uint32_t", "production_lhs", table.production_lhs(), 16);
+	emit_array(ss, "std::uint32_t", "production_length", table.production_length(), 16);
+	emit_array(ss, "std::string_view", "production_actions", table.production_actions(), 4);
+	emit_array(ss, "std::string_view", "symbol_names", table.symbol_names(), 4);
+
+	ss << "\t};\n";
+	ss << "}\n";
+
+	return ss.str();
+}
@@ -0,0 +1,246 @@
+#pragma once
+
+#include <vector>
+#include <span>
+#include <memory>
+#include <string>
+#include <limits>
+#include <cstdint>
+#include <cassert>
+
+#include <parser_compiler/parser_compiler.hpp>
+#include <runtime/binary_io.hpp>
+#include <runtime/parse_action.hpp>
+
+namespace fox_cc
+{
+	enum class parse_table_layout : std::uint32_t
+	{
+		dense, // ACTION and GOTO as full 2D arrays
+		compressed // row displacement with check arrays and default reductions, as in yacc
+	};
+
+	struct parse_table_builder;
+
+	// Flat representation of the LR automaton, ACTION indexed by [state][terminal] and GOTO by [state][non-terminal].
+	// Productions are numbered globally, in the order of their non-terminals and then of their rules. Entries are encoded
+	// as described in parse_action.
+	class parse_table : public parse_action
+	{
+		friend struct parse_table_builder;
+
+	public:
+		static inline constexpr std::uint32_t check_npos = std::numeric_limits<std::uint32_t>::max();
+		static inline constexpr std::uint32_t no_action = std::numeric_limits<std::uint32_t>::max();
+
+		// Arrays of the compressed layout. A row's entries are stored at base + column when check holds the row,
+		// everything else is the row's default. The packed arrays are padded so base + column is always in bounds.
+		struct compressed_tables
+		{
+			const entry* default_actions = nullptr; // [state] -> most common reduce of the row, error if it has none
+			const std::uint32_t* action_base = nullptr; // [state]
+			const std::uint32_t* action_check = nullptr; // [packed] -> state, check_npos if unused
+			const entry* action_entries = nullptr; // [packed]
+			size_t action_size = 0;
+
+			const std::uint32_t* default_gotos = nullptr; // [non-terminal - terminal_count] -> most common target
+			const std::uint32_t* goto_base = nullptr; // [non-terminal - terminal_count]
+			const std::uint32_t* goto_check = nullptr; // [packed] -> non-terminal - terminal_count, check_npos if unused
+			const std::uint32_t* goto_entries = nullptr; // [packed]
+			size_t goto_size = 0;
+		};
+
+	private:
+		parse_table_layout layout_ = parse_table_layout::dense;
+		size_t state_count_ = 0;
+		size_t terminal_count_ = 0;
+		size_t non_terminal_count_ = 0;
+		size_t production_count_ = 0;
+
+		table_storage storage_; // owns the arrays below
+		const entry* actions_ = nullptr; // [state][terminal] -> action, dense layout only
+		const std::uint32_t* gotos_ = nullptr; // [state][non-terminal - terminal_count] -> state, goto_npos if there is none, dense layout only
+		compressed_tables compressed_; // compressed layout only
+		const entry* default_reductions_ = nullptr; // [state] -> reduce taken without reading the lookahead, error_entry if the state needs it
+		const std::uint32_t* production_lhs_ = nullptr; // [production] -> non-terminal token id
+		const std::uint32_t* production_length_ = nullptr; // [production] -> symbols popped by the reduce
+		const std::uint32_t* production_offsets_ = nullptr; // [production] -> first symbol in production_symbols_, one past the last entry
+		const std::uint32_t* production_symbols_ = nullptr; // right-hand sides of the productions
+		const std::uint32_t* production_action_slots_ = nullptr; // [production] -> index in action_names_, no_action if it has none
+
+		std::vector<std::string> production_actions_; // [production] -> action name, empty if it has none
+		std::vector<std::string> action_names_; // [action slot] -> name, distinct
+		std::vector<std::string> symbol_names_; // [token] -> name
+
+	public:
+		parse_table() = default;
+		parse_table(const parse_table&) = default;
+		parse_table(parse_table&&) noexcept = default;
+		parse_table& operator=(const parse_table&) = default;
+		parse_table& operator=(parse_table&&) noexcept = default;
+		~parse_table() noexcept = default;
+
+	public:
+		explicit parse_table(const parser_compiler::parser_compiler_result& parser_result, parse_table_layout layout = parse_table_layout::dense);
+
+		// Same automaton in the other layout. Going from compressed to dense keeps the default reductions in place
+		// of the errors they cover, which only delays error detection until the reductions are done
+		[[nodiscard]] parse_table with_layout(parse_table_layout layout) const;
+
+	public:
+		void save(binary_writer& out) const;
+
+		[[nodiscard]] static parse_table load(binary_reader& in, table_storage storage);
+
+	public:
+		[[nodiscard]] parse_table_layout layout() const noexcept
+		{
+			return layout_;
+		}
+
+		[[nodiscard]] size_t state_count() const noexcept
+		{
+			return state_count_;
+		}
+
+		[[nodiscard]] size_t terminal_count() const noexcept
+		{
+			return terminal_count_;
+		}
+
+		[[nodiscard]] size_t non_terminal_count() const noexcept
+		{
+			return non_terminal_count_;
+		}
+
+		[[nodiscard]] size_t production_count() const noexcept
+		{
+			return production_count_;
+		}
+
+		[[nodiscard]] entry action(size_t state, size_t terminal) const noexcept
+		{
+			assert(state < state_count_ && terminal < terminal_count_);
+
+			if (layout_ == parse_table_layout::dense)
+				return actions_[state * terminal_count_ + terminal];
+
+			const size_t i = compressed_.action_base[state] + terminal;
+			return compressed_.action_check[i] == state ? compressed_.action_entries[i] : compressed_.default_actions[state];
+		}
+
+		// Reduce of a state that only reduces by one production, error_entry if the action depends on the lookahead
+		[[nodiscard]] entry default_reduction(size_t state) const noexcept
+		{
+			assert(state < state_count_);
+			return default_reductions_[state];
+		}
+
+		[[nodiscard]] std::uint32_t go_to(size_t state, size_t non_terminal) const noexcept
+		{
+			assert(state < state_count_ && non_terminal >= terminal_count_ && non_terminal < terminal_count_ + non_terminal_count_);
+			const size_t column = non_terminal - terminal_count_;
+
+			if (layout_ == parse_table_layout::dense)
+				return gotos_[state * non_terminal_count_ + column];
+
+			const size_t i = compressed_.goto_base[column] + state;
+			return compressed_.goto_check[i] == column ? compressed_.goto_entries[i] : compressed_.default_gotos[column];
+		}
+
+		[[nodiscard]] size_t production_lhs(size_t production) const noexcept
+		{
+			return production_lhs_[production];
+		}
+
+		[[nodiscard]] size_t production_length(size_t production) const noexcept
+		{
+			return production_length_[production];
+		}
+
+		[[nodiscard]] std::span<const std::uint32_t> production_rhs(size_t production) const noexcept
+		{
+			return std::span(
+				production_symbols_ + production_offsets_[production],
+				production_symbols_ + production_offsets_[production + 1]
+			);
+		}
+
+		[[nodiscard]] const std::string& production_action(size_t production) const noexcept
+		{
+			return production_actions_[production];
+		}
+
+		// Productions with the same action share its slot, slots are dense in [0, action_names().size())
+		[[nodiscard]] std::uint32_t action_slot(size_t production) const noexcept
+		{
+			return production_action_slots_[production];
+		}
+
+		[[nodiscard]] const std::string& symbol_name(size_t token) const noexcept
+		{
+			return symbol_names_[token];
+		}
+
+		// Bytes taken by the ACTION and GOTO arrays
+		[[nodiscard]] size_t table_size() const noexcept;
+
+	public:
+		// Dense layout only
+		[[nodiscard]] std::span<const entry> actions() const noexcept
+		{
+			return { actions_, layout_ == parse_table_layout::dense ? state_count_ * terminal_count_ : 0 };
+		}
+
+		// Dense layout only
+		[[nodiscard]] std::span<const std::uint32_t> gotos() const noexcept
+		{
+			return { gotos_, layout_ == parse_table_layout::dense ? state_count_ * non_terminal_count_ : 0 };
+		}
+
+		// Compressed layout only
+		[[nodiscard]] const compressed_tables& compressed() const noexcept
+		{
+			return compressed_;
+		}
+
+		[[nodiscard]] std::span<const entry> default_reductions() const noexcept
+		{
+			return { default_reductions_, state_count_ };
+		}
+
+		[[nodiscard]] std::span<const std::uint32_t> production_lhs() const noexcept
+		{
+			return { production_lhs_, production_count_ };
+		}
+
+		[[nodiscard]] std::span<const std::uint32_t> production_length() const noexcept
+		{
+			return { production_length_, production_count_ };
+		}
+
+		[[nodiscard]] const std::vector<std::string>& production_actions() const noexcept
+		{
+			return production_actions_;
+		}
+
+		[[nodiscard]] std::span<const std::uint32_t> production_action_slots() const noexcept
+		{
+			return { production_action_slots_, production_count_ };
+		}
+
+		[[nodiscard]] const std::vector<std::string>& action_names() const noexcept
+		{
+			return action_names_;
+		}
+
+		[[nodiscard]] const std::vector<std::string>& symbol_names() const noexcept
+		{
+			return symbol_names_;
+		}
+	};
+
+	// Emits a standalone C++ header with the tables as constexpr arrays in a struct named tables, which
+	// fox_cc::static_parser runs
+	[[nodiscard]] std::string emit_parser_cpp(const parse_table& table, std::string_view name_space);
+}
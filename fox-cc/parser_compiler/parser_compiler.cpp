@@ -1,4 +1,5 @@
 #include <functional>
+#include <algorithm>
 #include <parser_compiler/parser_compiler.hpp>
 
 fox_cc::parser_compiler::parser_compiler(const lex_compiler::lex_compiler_result& lex_result, const prs::yacc_ast& ast)
@@ -47,11 +48,15 @@ void fox_cc::parser_compiler::init_non_terminals()
 	}
 
 	// Parse productions
+	size_t production_count = 0;
 	for(size_t i = first_non_terminal_, j = 0; i < std::size(result_.tokens); ++i, ++j)
 	{
 		auto& production = result_.tokens[i].non_terminal();
 		auto& ast_production = ast_.productions[j];
 
+		production.first_production = production_count;
+		production_count += std::size(ast_production.rules);
+
 		for(const auto& rule : ast_production.rules)
 		{
 			auto& prod = production.productions.emplace_back();
@@ -85,6 +90,17 @@ void fox_cc::parser_compiler::init_non_terminals()
 			}
 
 			prod.shrink_to_fit();
+
+			// Productions sharing an action share its slot
+			auto& slot = production.action_slots.emplace_back(parser_compiler_result::action_npos);
+			if (!std::empty(prod_action))
+			{
+				const auto f = std::ranges::find(result_.actions, prod_action);
+				slot = static_cast<size_t>(f - std::begin(result_.actions));
+
+				if (f == std::end(result_.actions))
+					result_.actions.push_back(prod_action);
+			}
 		}
 	}
 }
@@ -350,7 +366,8 @@ void fox_cc::parser_compiler::compute_actions()
 		for(size_t i = 0; i < std::size(v.productions); ++i)
 		{
 			const auto& prod = v.productions[i];
-			const auto& source_production = result_.tokens[prod.non_terminal].non_terminal().productions[prod.non_terminal_production];
+			const auto& non_terminal = result_.tokens[prod.non_terminal].non_terminal();
+			const auto& source_production = non_terminal.productions[prod.non_terminal_production];
 
 			if(prod.current == std::size(source_production))
 			{
@@ -368,7 +385,9 @@ void fox_cc::parser_compiler::compute_actions()
 					auto action = parser_compiler_result::state_data::action_reduce{
 						prod.non_terminal,
 						std::size(source_production),
-						prod.non_terminal
+						prod.non_terminal,
+						non_terminal.first_production + prod.non_terminal_production,
+						non_terminal.action_slots[prod.non_terminal_production]
 					};
 
 					for (auto follow : prod.follow_set)
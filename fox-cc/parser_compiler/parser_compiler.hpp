@@ -18,6 +18,7 @@ namespace fox_cc
 			using token_id = size_t;
 			static inline constexpr token_id token_id_npos = std::numeric_limits<token_id>::max();
 			static inline constexpr token_id end_token = static_cast<token_id>(0);
+			static inline constexpr size_t action_npos = std::numeric_limits<size_t>::max();
 
 			struct terminal
 			{
@@ -32,6 +33,8 @@ namespace fox_cc
 				std::string name;
 				std::vector<std::vector<size_t>> productions;
 				std::vector<std::string> production_actions;
+				std::vector<size_t> action_slots; // [production] -> index in actions, action_npos if it has none
+				size_t first_production = 0; // global index of productions[0], productions are numbered in the order of their non-terminals
 			};
 
 			struct token : std::variant<terminal, non_terminal>
@@ -137,6 +140,8 @@ namespace fox_cc
 					size_t production_id;
 					size_t pop_count;
 					size_t push_state;
+					size_t production; // global index
+					size_t action_slot; // index in actions, action_npos if the production has none
 				};
 
 				struct action_shift
@@ -149,6 +154,7 @@ namespace fox_cc
 			};
 
 			std::vector<token> tokens;
+			std::vector<std::string> actions; // distinct semantic action names, indexed by action slot
 			automata::dfa<state_data, size_t, size_t> dfa;
 		};
 
@@ -0,0 +1,155 @@
+#pragma once
+
+#include <string>
+#include <memory>
+#include <string_view>
+#include <span>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+
+namespace fox_cc
+{
+	inline constexpr std::uint64_t fnv1a_basis = 0xcbf29ce484222325ull;
+
+	// 64-bit FNV-1a, continues from hash
+	[[nodiscard]] inline std::uint64_t fnv1a(std::string_view data, std::uint64_t hash = fnv1a_basis) noexcept
+	{
+		for (const char c : data)
+		{
+			hash ^= static_cast<unsigned char>(c);
+			hash *= 0x100000001b3ull;
+		}
+
+		return hash;
+	}
+
+	// Native-endian binary buffer, arrays are aligned to 8 bytes so they can be used in place from a mapping
+	class binary_writer
+	{
+		std::string buffer_;
+
+	public:
+		static inline constexpr size_t alignment = 8;
+
+	public:
+		[[nodiscard]] const std::string& buffer() const noexcept
+		{
+			return buffer_;
+		}
+
+		[[nodiscard]] size_t size() const noexcept
+		{
+			return std::size(buffer_);
+		}
+
+		void align()
+		{
+			buffer_.resize((std::size(buffer_) + alignment - 1) / alignment * alignment, '\0');
+		}
+
+		template<class T> requires std::is_trivially_copyable_v<T>
+		void write(const T& value)
+		{
+			buffer_.append(reinterpret_cast<const char*>(std::addressof(value)), sizeof(T));
+		}
+
+		// Writes the element count followed by the aligned elements
+		template<class T> requires std::is_trivially_copyable_v<T>
+		void write_array(std::span<const T> values)
+		{
+			write(static_cast<std::uint64_t>(std::size(values)));
+			align();
+			buffer_.append(reinterpret_cast<const char*>(std::data(values)), std::size(values) * sizeof(T));
+			align();
+		}
+
+		void write_string(std::string_view str)
+		{
+			write(static_cast<std::uint64_t>(std::size(str)));
+			buffer_.append(str);
+		}
+	};
+
+	// Owner of the arrays of lex_table and parse_table, either the table's own buffers or a mapped grammar file. The arrays
+	// are immutable, so copies of a table share them, and tables loaded from a binary_reader use its data in place, so
+	// the storage passed to load must keep that data alive
+	using table_storage = std::shared_ptr<const void>;
+
+	// Reads what binary_writer wrote, arrays are returned as views of the data. Throws std::runtime_error on truncated data
+	class binary_reader
+	{
+		std::string_view data_;
+		size_t position_ = 0;
+
+	public:
+		binary_reader() = delete;
+
+		explicit binary_reader(std::string_view data) noexcept
+			: data_(data) {}
+
+	public:
+		[[nodiscard]] size_t position() const noexcept
+		{
+			return position_;
+		}
+
+		void seek(size_t position)
+		{
+			if (position > std::size(data_))
+				throw std::runtime_error("Truncated grammar file.");
+
+			position_ = position;
+		}
+
+		void align()
+		{
+			seek((position_ + binary_writer::alignment - 1) / binary_writer::alignment * binary_writer::alignment);
+		}
+
+		template<class T> requires std::is_trivially_copyable_v<T>
+		[[nodiscard]] T read()
+		{
+			T value;
+			std::memcpy(std::addressof(value), take(sizeof(T)), sizeof(T));
+			return value;
+		}
+
+		template<class T> requires std::is_trivially_copyable_v<T>
+		[[nodiscard]] std::span<const T> read_array()
+		{
+			const auto count = read<std::uint64_t>();
+			align();
+
+			if (count > (std::size(data_) - position_) / sizeof(T))
+				throw std::runtime_error("Truncated grammar file.");
+
+			// The data starts at an aligned address, so aligned offsets are aligned for T
+			const auto* values = reinterpret_cast<const T*>(take(count * sizeof(T)));
+			align();
+			return { values, static_cast<size_t>(count) };
+		}
+
+		[[nodiscard]] std::string_view read_string()
+		{
+			const auto size = read<std::uint64_t>();
+
+			if (size > std::size(data_) - position_)
+				throw std::runtime_error("Truncated grammar file.");
+
+			return { take(size), static_cast<size_t>(size) };
+		}
+
+	private:
+		[[nodiscard]] const char* take(size_t size)
+		{
+			if (size > std::size(data_) - position_)
+				throw std::runtime_error("Truncated grammar file.");
+
+			const char* out = std::data(data_) + position_;
+			position_ += size;
+			return out;
+		}
+	};
+}
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <coroutine>
+#include <iterator>
+#include <memory>
+#include <utility>
+
+namespace fox_cc
+{
+	// Lazily evaluated sequence of a coroutine's co_yields, an input range. Yielded values are referenced, not copied,
+	// and stay valid until the coroutine is resumed. Exceptions of the coroutine propagate out of begin() and ++
+	template<class T>
+	class generator
+	{
+	public:
+		struct promise_type
+		{
+			const T* value_ = nullptr;
+
+			[[nodiscard]] generator get_return_object() noexcept
+			{
+				return generator(std::coroutine_handle<promise_type>::from_promise(*this));
+			}
+
+			[[nodiscard]] std::suspend_always initial_suspend() const noexcept
+			{
+				return {};
+			}
+
+			[[nodiscard]] std::suspend_always final_suspend() const noexcept
+			{
+				return {};
+			}
+
+			std::suspend_always yield_value(const T& value) noexcept
+			{
+				value_ = std::addressof(value);
+				return {};
+			}
+
+			void return_void() const noexcept {}
+
+			void unhandled_exception() const
+			{
+				throw;
+			}
+		};
+
+		class iterator
+		{
+			std::coroutine_handle<promise_type> handle_;
+
+		public:
+			using iterator_concept = std::input_iterator_tag;
+			using value_type = T;
+			using difference_type = std::ptrdiff_t;
+
+			iterator() = default;
+
+			explicit iterator(std::coroutine_handle<promise_type> handle) noexcept
+				: handle_(handle) {}
+
+			[[nodiscard]] const T& operator*() const noexcept
+			{
+				return *handle_.promise().value_;
+			}
+
+			[[nodiscard]] const T* operator->() const noexcept
+			{
+				return handle_.promise().value_;
+			}
+
+			iterator& operator++()
+			{
+				handle_.resume();
+				return *this;
+			}
+
+			void operator++(int)
+			{
+				++*this;
+			}
+
+			[[nodiscard]] bool operator==(std::default_sentinel_t) const noexcept
+			{
+				return !handle_ || handle_.done();
+			}
+		};
+
+	private:
+		std::coroutine_handle<promise_type> handle_;
+
+		explicit generator(std::coroutine_handle<promise_type> handle) noexcept
+			: handle_(handle) {}
+
+	public:
+		generator() = delete;
+		generator(const generator&) = delete;
+		generator& operator=(const generator&) = delete;
+
+		generator(generator&& other) noexcept
+			: handle_(std::exchange(other.handle_, {}))
+		{}
+
+		generator& operator=(generator&& other) noexcept
+		{
+			if (handle_)
+				handle_.destroy();
+
+			handle_ = std::exchange(other.handle_, {});
+			return *this;
+		}
+
+		~generator() noexcept
+		{
+			if (handle_)
+				handle_.destroy();
+		}
+
+	public:
+		// Runs the coroutine to its first co_yield, can be called once
+		[[nodiscard]] iterator begin()
+		{
+			handle_.resume();
+			return iterator(handle_);
+		}
+
+		[[nodiscard]] std::default_sentinel_t end() const noexcept
+		{
+			return {};
+		}
+	};
+}
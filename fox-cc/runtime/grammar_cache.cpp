@@ -0,0 +1,93 @@
+#include <runtime/grammar_cache.hpp>
+
+#include <cstdlib>
+#include <random>
+#include <sstream>
+#include <iomanip>
+#include <initializer_list>
+
+std::uint64_t fox_cc::grammar_hash(std::string_view language) noexcept
+{
+	std::uint64_t hash = fnv1a_basis;
+
+	// Little-endian, so the keys don't depend on the machine
+	for (const auto version : { grammar_file_version, generator_version })
+	{
+		for (size_t i = 0; i < sizeof(version); ++i)
+		{
+			const auto byte = static_cast<char>(version >> (i * 8));
+			hash = fnv1a(std::string_view(&byte, 1), hash);
+		}
+	}
+
+	return fnv1a(language, hash);
+}
+
+std::filesystem::path fox_cc::grammar_cache_path(std::string_view language)
+{
+	const char* dir = std::getenv(grammar_cache_env);
+	if (dir == nullptr || *dir == '\0')
+		return {};
+
+	std::stringstream ss;
+	ss << std::hex << std::setw(16) << std::setfill('0') << grammar_hash(language) << ".fcg";
+
+	return std::filesystem::path(dir) / ss.str();
+}
+
+std::optional<fox_cc::grammar_file> fox_cc::load_cached_grammar(std::string_view language)
+{
+	const auto path = grammar_cache_path(language);
+	if (path.empty())
+		return std::nullopt;
+
+	std::error_code ec;
+	if (!std::filesystem::exists(path, ec))
+		return std::nullopt;
+
+	try
+	{
+		// The name is only a 64-bit hash, an entry of another grammar with the same one is a miss
+		auto out = load_grammar(path);
+		if (out.source != language)
+			return std::nullopt;
+
+		return out;
+	}
+	catch (const std::exception&)
+	{
+		return std::nullopt; // stale or damaged, it is regenerated and replaced
+	}
+}
+
+void fox_cc::store_cached_grammar(std::string_view language, const grammar_file& grammar) noexcept
+{
+	std::filesystem::path tmp;
+	std::error_code ec;
+
+	try
+	{
+		const auto path = grammar_cache_path(language);
+		if (path.empty())
+			return;
+
+		std::filesystem::create_directories(path.parent_path(), ec);
+
+		// Unique per writer, concurrent processes compiling the same grammar each rename a complete file
+		std::stringstream ss;
+		ss << path.filename().string() << '.' << std::hex << std::random_device{}() << ".tmp";
+		tmp = path.parent_path() / ss.str();
+
+		save_grammar(tmp, grammar);
+
+		std::filesystem::rename(tmp, path, ec);
+		if (!ec)
+			return;
+	}
+	catch (...)
+	{
+	}
+
+	if (!tmp.empty())
+		std::filesystem::remove(tmp, ec);
+}
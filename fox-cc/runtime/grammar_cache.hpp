@@ -0,0 +1,32 @@
+#pragma once
+
+#include <string_view>
+#include <filesystem>
+#include <optional>
+#include <cstdint>
+
+#include <runtime/grammar_file.hpp>
+
+namespace fox_cc
+{
+	// Directory of the compiled grammar cache, taken from the environment variable, the cache is off if it isn't set
+	inline constexpr const char* grammar_cache_env = "FOX_CC_CACHE_DIR";
+
+	// Bumped whenever the lexer or parser generator changes the tables it builds for the same grammar, with or without
+	// a change of the file format, so cached tables of older generators are never used
+	inline constexpr std::uint32_t generator_version = 1;
+
+	// FNV-1a of the grammar text, grammar_file_version and generator_version
+	[[nodiscard]] std::uint64_t grammar_hash(std::string_view language) noexcept;
+
+	// Path of the cached grammar, empty if the cache is off
+	[[nodiscard]] std::filesystem::path grammar_cache_path(std::string_view language);
+
+	// Cached tables of the grammar, nullopt if the cache is off, misses, or holds an unreadable file or the tables of
+	// another grammar. Entries record the grammar text and only one recording this exact text is used
+	[[nodiscard]] std::optional<grammar_file> load_cached_grammar(std::string_view language);
+
+	// Writes the tables with the grammar text, which grammar.source has to hold, to a temporary file and renames it
+	// over the cache entry, so readers never see a partial file. Failures are ignored, the cache is only an optimization
+	void store_cached_grammar(std::string_view language, const grammar_file& grammar) noexcept;
+}
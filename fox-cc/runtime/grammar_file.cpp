@@ -0,0 +1,113 @@
+#include <runtime/grammar_file.hpp>
+#include <runtime/mapped_file.hpp>
+#include <runtime/binary_io.hpp>
+
+#include <fstream>
+#include <memory>
+#include <system_error>
+#include <cstring>
+
+namespace
+{
+	constexpr char magic[8] = { 'f', 'o', 'x', '-', 'c', 'c', 'g', 'r' };
+	constexpr std::uint32_t endian_tag = 0x01020304;
+}
+
+std::string fox_cc::serialize_grammar(const grammar_file& grammar)
+{
+	binary_writer out;
+
+	for (const char c : magic)
+		out.write(c);
+
+	out.write(endian_tag);
+	out.write(grammar_file_version);
+	out.write_string(grammar.source);
+
+	out.write(static_cast<std::uint64_t>(std::size(grammar.terminals)));
+	for (const auto& terminal : grammar.terminals)
+	{
+		out.write_string(terminal.name);
+		out.write_string(terminal.type);
+		out.write(static_cast<std::uint32_t>(terminal.assoc));
+	}
+
+	out.align();
+	grammar.lexer.save(out);
+	grammar.parser.save(out);
+
+	out.align();
+	out.write(fnv1a(out.buffer()));
+
+	return out.buffer();
+}
+
+void fox_cc::save_grammar(const std::filesystem::path& path, const grammar_file& grammar)
+{
+	const auto data = serialize_grammar(grammar);
+
+	std::ofstream f(path, std::ios::binary | std::ios::trunc | std::ios::out);
+	f.write(std::data(data), static_cast<std::streamsize>(std::size(data)));
+
+	if (!f)
+		throw std::system_error(std::make_error_code(std::errc::io_error), "Failed to write " + path.string());
+}
+
+fox_cc::grammar_file fox_cc::load_grammar(const std::filesystem::path& path)
+{
+	// The tables are used in place and looked up at random for as long as the grammar lives
+	auto file = std::make_shared<const mapped_file>(path, file_access::random);
+
+	auto data = file->view();
+	if (std::size(data) < sizeof(std::uint64_t))
+		throw std::runtime_error("Truncated grammar file.");
+
+	std::uint64_t checksum;
+	std::memcpy(std::addressof(checksum), std::data(data) + std::size(data) - sizeof(checksum), sizeof(checksum));
+	data.remove_suffix(sizeof(checksum));
+
+	binary_reader in(data);
+
+	for (const char c : magic)
+	{
+		if (in.read<char>() != c)
+			throw std::runtime_error("Not a grammar file.");
+	}
+
+	if (in.read<std::uint32_t>() != endian_tag)
+		throw std::runtime_error("Grammar file was written with a different endianness.");
+
+	if (in.read<std::uint32_t>() != grammar_file_version)
+		throw std::runtime_error("Grammar file version mismatch.");
+
+	// The tables are used in place, damage anywhere is caught before they are
+	if (fnv1a(data) != checksum)
+		throw std::runtime_error("Grammar file checksum mismatch.");
+
+	grammar_file out;
+	out.source = in.read_string();
+
+	const auto terminal_count = in.read<std::uint64_t>();
+	for (std::uint64_t i = 0; i < terminal_count; ++i)
+	{
+		auto& terminal = out.terminals.emplace_back();
+		terminal.name = in.read_string();
+		terminal.type = in.read_string();
+		terminal.assoc = static_cast<lex_compiler::lex_compiler_result::associativity>(in.read<std::uint32_t>());
+	}
+
+	in.align();
+	out.lexer = lex_table::load(in, file);
+	out.parser = parse_table::load(in, file);
+
+	if (out.parser.terminal_count() != std::size(out.terminals))
+		throw std::runtime_error("Invalid grammar file.");
+
+	for (size_t i = 0; i < std::size(out.lexer); ++i)
+	{
+		if (const auto id = out.lexer.accept(i); id != lex_table::token_npos && id >= std::size(out.terminals))
+			throw std::runtime_error("Invalid grammar file.");
+	}
+
+	return out;
+}
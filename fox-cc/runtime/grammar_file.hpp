@@ -0,0 +1,35 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <filesystem>
+#include <cstdint>
+
+#include <lex_compiler/lex_compiler.hpp>
+#include <lex_compiler/lex_table.hpp>
+#include <parser_compiler/parse_table.hpp>
+
+namespace fox_cc
+{
+	// Bumped whenever the layout of the file or of the tables changes, older files are rejected
+	inline constexpr std::uint32_t grammar_file_version = 6;
+
+	// Compiled grammar, everything the runtime needs without running the generator
+	struct grammar_file
+	{
+		std::vector<lex_compiler::lex_compiler_result::lex_token> terminals;
+		lex_table lexer;
+		parse_table parser;
+		std::string source; // grammar text the tables were generated from, empty if not recorded
+	};
+
+	// Layout: magic, endian tag, version, source, terminals, lexer table, parse table, FNV-1a of everything before it. Values
+	// are native-endian, a file written on a machine of the other endianness is rejected
+	[[nodiscard]] std::string serialize_grammar(const grammar_file& grammar);
+
+	void save_grammar(const std::filesystem::path& path, const grammar_file& grammar);
+
+	// Maps the file, the lexer and parse tables are used in place and keep the mapping alive. Throws std::system_error if the file
+	// can't be read and std::runtime_error if it isn't an intact grammar file of this version or its tables are out of bounds
+	[[nodiscard]] grammar_file load_grammar(const std::filesystem::path& path);
+}
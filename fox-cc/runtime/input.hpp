@@ -0,0 +1,145 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <functional>
+#include <istream>
+#include <span>
+#include <cassert>
+
+namespace fox_cc
+{
+	// Fills the buffer with the next bytes of the input, returns the number of bytes written, 0 at the end of the input
+	using chunk_source = std::function<size_t(std::span<char>)>;
+
+	[[nodiscard]] inline chunk_source istream_source(std::istream& is)
+	{
+		return [&is](std::span<char> buffer) -> size_t
+		{
+			is.read(std::data(buffer), static_cast<std::streamsize>(std::size(buffer)));
+			return static_cast<size_t>(is.gcount());
+		};
+	}
+
+	// Inputs the runtime lexer reads from, positions are absolute offsets from the start of the input
+
+	// Whole input held in memory
+	class string_input
+	{
+		std::string_view input_;
+
+	public:
+		static inline constexpr bool stable = true; // views of the input stay valid after release
+
+	public:
+		string_input() = delete;
+
+		string_input(std::string_view input) noexcept
+			: input_(input) {}
+
+		string_input(const string_input&) = default;
+		string_input(string_input&&) noexcept = default;
+		string_input& operator=(const string_input&) = default;
+		string_input& operator=(string_input&&) noexcept = default;
+		~string_input() noexcept = default;
+
+	public:
+		// Returns false if i is past the end of the input
+		[[nodiscard]] bool fetch(size_t i) const noexcept
+		{
+			return i < std::size(input_);
+		}
+
+		[[nodiscard]] char operator[](size_t i) const noexcept
+		{
+			assert(i < std::size(input_));
+			return input_[i];
+		}
+
+		[[nodiscard]] std::string_view view(size_t begin, size_t end) const noexcept
+		{
+			return input_.substr(begin, end - begin);
+		}
+
+		// Bytes before i won't be read again
+		void release(size_t) noexcept {}
+	};
+
+	// Bounded window over a chunk source, only bytes since the last release are kept
+	class chunked_input
+	{
+		chunk_source source_;
+		size_t chunk_size_;
+
+		std::string buffer_; // holds bytes [offset_, offset_ + size(buffer_))
+		size_t offset_ = 0;
+		size_t released_ = 0;
+		bool end_ = false;
+
+	public:
+		static inline constexpr bool stable = false;
+		static inline constexpr size_t default_chunk_size = 64 * 1024;
+
+	public:
+		chunked_input() = delete;
+
+		chunked_input(chunk_source source, size_t chunk_size = default_chunk_size)
+			: source_(std::move(source)), chunk_size_(chunk_size)
+		{
+			assert(chunk_size_ != 0);
+		}
+
+		chunked_input(const chunked_input&) = delete;
+		chunked_input(chunked_input&&) noexcept = default;
+		chunked_input& operator=(const chunked_input&) = delete;
+		chunked_input& operator=(chunked_input&&) noexcept = default;
+		~chunked_input() noexcept = default;
+
+	public:
+		// Reads chunks until byte i is in the window, returns false if i is past the end of the input
+		[[nodiscard]] bool fetch(size_t i)
+		{
+			assert(i >= offset_);
+
+			while (i >= offset_ + std::size(buffer_))
+			{
+				if (end_)
+					return false;
+
+				const size_t old_size = std::size(buffer_);
+				buffer_.resize(old_size + chunk_size_);
+				const size_t read = source_(std::span(std::data(buffer_) + old_size, chunk_size_));
+				buffer_.resize(old_size + read);
+
+				end_ = (read == 0);
+			}
+
+			return true;
+		}
+
+		[[nodiscard]] char operator[](size_t i) const noexcept
+		{
+			assert(i >= offset_ && i < offset_ + std::size(buffer_));
+			return buffer_[i - offset_];
+		}
+
+		[[nodiscard]] std::string_view view(size_t begin, size_t end) const noexcept
+		{
+			assert(begin >= offset_ && end <= offset_ + std::size(buffer_));
+			return std::string_view(buffer_).substr(begin - offset_, end - begin);
+		}
+
+		// Bytes before i won't be read again, the window is compacted once they take up half of it
+		void release(size_t i)
+		{
+			released_ = std::max(released_, i);
+
+			const size_t dead = released_ - offset_;
+			if (dead >= chunk_size_ && dead * 2 >= std::size(buffer_))
+			{
+				buffer_.erase(0, dead);
+				offset_ = released_;
+			}
+		}
+	};
+}
@@ -0,0 +1,127 @@
+#include <runtime/mapped_file.hpp>
+
+#include <system_error>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+#ifdef _WIN32
+
+fox_cc::mapped_file::mapped_file(const std::filesystem::path& path, file_access access)
+{
+	const DWORD hint = access == file_access::sequential ? FILE_FLAG_SEQUENTIAL_SCAN : FILE_FLAG_RANDOM_ACCESS;
+
+	file_ = ::CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, hint, nullptr);
+	if (file_ == INVALID_HANDLE_VALUE)
+	{
+		file_ = nullptr;
+		throw std::system_error(static_cast<int>(::GetLastError()), std::system_category(), "Failed to open the file.");
+	}
+
+	LARGE_INTEGER size;
+	if (!::GetFileSizeEx(file_, &size))
+	{
+		const auto error = ::GetLastError();
+		this->clear();
+		throw std::system_error(static_cast<int>(error), std::system_category(), "Failed to read the file size.");
+	}
+
+	size_ = static_cast<size_t>(size.QuadPart);
+
+	// Empty files can't be mapped
+	if (size_ == 0)
+		return;
+
+	mapping_ = ::CreateFileMappingW(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (mapping_ == nullptr)
+	{
+		const auto error = ::GetLastError();
+		this->clear();
+		throw std::system_error(static_cast<int>(error), std::system_category(), "Failed to map the file.");
+	}
+
+	data_ = static_cast<const char*>(::MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+	if (data_ == nullptr)
+	{
+		const auto error = ::GetLastError();
+		this->clear();
+		throw std::system_error(static_cast<int>(error), std::system_category(), "Failed to map the file.");
+	}
+}
+
+void fox_cc::mapped_file::clear() noexcept
+{
+	if (data_ != nullptr)
+		::UnmapViewOfFile(data_);
+
+	if (mapping_ != nullptr)
+		::CloseHandle(mapping_);
+
+	if (file_ != nullptr)
+		::CloseHandle(file_);
+
+	data_ = nullptr;
+	size_ = 0;
+	mapping_ = nullptr;
+	file_ = nullptr;
+}
+
+#else
+
+fox_cc::mapped_file::mapped_file(const std::filesystem::path& path, file_access access)
+{
+	fd_ = ::open(path.c_str(), O_RDONLY);
+	if (fd_ == -1)
+		throw std::system_error(errno, std::generic_category(), "Failed to open the file.");
+
+	struct stat st;
+	if (::fstat(fd_, &st) == -1)
+	{
+		const auto error = errno;
+		this->clear();
+		throw std::system_error(error, std::generic_category(), "Failed to read the file size.");
+	}
+
+	size_ = static_cast<size_t>(st.st_size);
+
+	// Empty files can't be mapped
+	if (size_ == 0)
+		return;
+
+	void* data = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+	if (data == MAP_FAILED)
+	{
+		const auto error = errno;
+		this->clear();
+		throw std::system_error(error, std::generic_category(), "Failed to map the file.");
+	}
+
+	data_ = static_cast<const char*>(data);
+
+	// Only a hint
+	::madvise(data, size_, access == file_access::sequential ? MADV_SEQUENTIAL : MADV_RANDOM);
+}
+
+void fox_cc::mapped_file::clear() noexcept
+{
+	if (data_ != nullptr)
+		::munmap(const_cast<char*>(data_), size_);
+
+	if (fd_ != -1)
+		::close(fd_);
+
+	data_ = nullptr;
+	size_ = 0;
+	fd_ = -1;
+}
+
+#endif
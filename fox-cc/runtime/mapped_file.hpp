@@ -0,0 +1,88 @@
+#pragma once
+
+#include <string_view>
+#include <filesystem>
+#include <utility>
+
+namespace fox_cc
+{
+	// How a mapping will be read, passed to the OS as a paging hint
+	enum class file_access
+	{
+		sequential, // read front to back once, pages behind the reader can be dropped early
+		random // read in place at arbitrary offsets for as long as it is mapped
+	};
+
+	// Read-only memory mapping of a whole file
+	class mapped_file
+	{
+		const char* data_ = nullptr;
+		size_t size_ = 0;
+
+#ifdef _WIN32
+		void* file_ = nullptr;
+		void* mapping_ = nullptr;
+#else
+		int fd_ = -1;
+#endif
+
+	public:
+		void clear() noexcept;
+
+	public:
+		mapped_file() = default;
+
+		explicit mapped_file(const std::filesystem::path& path, file_access access = file_access::sequential);
+
+		mapped_file(const mapped_file&) = delete;
+		mapped_file& operator=(const mapped_file&) = delete;
+
+		mapped_file(mapped_file&& other) noexcept
+			:
+			data_(std::exchange(other.data_, {})),
+			size_(std::exchange(other.size_, {})),
+#ifdef _WIN32
+			file_(std::exchange(other.file_, {})),
+			mapping_(std::exchange(other.mapping_, {}))
+#else
+			fd_(std::exchange(other.fd_, -1))
+#endif
+		{}
+
+		mapped_file& operator=(mapped_file&& other) noexcept
+		{
+			this->clear();
+
+			data_ = std::exchange(other.data_, {});
+			size_ = std::exchange(other.size_, {});
+#ifdef _WIN32
+			file_ = std::exchange(other.file_, {});
+			mapping_ = std::exchange(other.mapping_, {});
+#else
+			fd_ = std::exchange(other.fd_, -1);
+#endif
+			return *this;
+		}
+
+		~mapped_file() noexcept
+		{
+			this->clear();
+		}
+
+	public:
+		[[nodiscard]] const char* data() const noexcept
+		{
+			return data_;
+		}
+
+		[[nodiscard]] size_t size() const noexcept
+		{
+			return size_;
+		}
+
+		[[nodiscard]] std::string_view view() const noexcept
+		{
+			return { data_, size_ };
+		}
+	};
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <limits>
+#include <cstdint>
+#include <cstddef>
+
+namespace fox_cc
+{
+	// Encoding of the ACTION entries, shared by parse_table and the tables emitted for static_parser.
+	// An entry packs the operand above the kind, (operand << kind_bits) | kind
+	struct parse_action
+	{
+		using entry = std::uint32_t;
+
+		enum class action_kind : std::uint8_t
+		{
+			error,
+			shift, // operand is the state to push
+			reduce, // operand is the production
+			accept
+		};
+
+		static inline constexpr size_t kind_bits = 2;
+		static inline constexpr entry error_entry = 0;
+		static inline constexpr std::uint32_t goto_npos = std::numeric_limits<std::uint32_t>::max();
+
+		[[nodiscard]] static constexpr entry make_entry(action_kind kind, size_t operand) noexcept
+		{
+			return static_cast<entry>(operand << kind_bits) | static_cast<entry>(kind);
+		}
+
+		[[nodiscard]] static constexpr action_kind kind(entry e) noexcept
+		{
+			return static_cast<action_kind>(e & ((1u << kind_bits) - 1));
+		}
+
+		[[nodiscard]] static constexpr size_t operand(entry e) noexcept
+		{
+			return static_cast<size_t>(e >> kind_bits);
+		}
+	};
+}
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <string_view>
+#include <span>
+#include <cstdint>
+#include <type_traits>
+
+namespace fox_cc
+{
+	// Symbol handed to view actions
+	struct token_view
+	{
+		size_t id; // terminal or non-terminal id, indexes parser_compiler_result::tokens
+		std::string_view lexeme; // lexeme of a terminal, value of a non-terminal
+	};
+
+	template<class Value>
+	class basic_compiler;
+
+	// Values like std::string, whose elements are copied bytewise, so copying one into a buffer that fits it is cheap
+	template<class T>
+	concept flat_buffer = requires(const T& v)
+	{
+		typename T::value_type;
+		v.size();
+		v.capacity();
+	} && std::is_trivially_copyable_v<typename T::value_type> && std::is_copy_assignable_v<T>;
+
+	// Stacks of a parse. A session passed to every compile() keeps their capacity, so steady-state parsing doesn't
+	// allocate beyond what actions allocate and the returned value. Slots above the top of the value stack aren't
+	// destroyed, values and lexemes are assigned into them and values like std::string keep their buffers
+	template<class Value>
+	class parse_session
+	{
+		template<class>
+		friend class basic_compiler;
+
+		struct symbol
+		{
+			size_t id;
+			std::string_view lexeme; // terminals of inputs that outlive the parse, points into the input
+			std::string text; // terminals of streamed inputs
+
+			[[nodiscard]] std::string_view terminal() const noexcept
+			{
+				return std::empty(text) ? lexeme : std::string_view(text);
+			}
+		};
+
+		std::vector<std::uint32_t> states_; // LR states, one more than there are values until the parse is finished
+		std::vector<Value> values_; // [0, depth_) is the value stack
+		std::vector<symbol> symbols_; // [0, depth_) -> symbol of the value
+		std::vector<token_view> views_; // arguments of view actions
+		size_t depth_ = 0;
+		bool actions_ = true; // false for parses that only walk the tables, terminals aren't converted either
+
+	public:
+		parse_session() = default;
+		parse_session(const parse_session&) = default;
+		parse_session(parse_session&&) noexcept = default;
+		parse_session& operator=(const parse_session&) = default;
+		parse_session& operator=(parse_session&&) noexcept = default;
+		~parse_session() noexcept = default;
+
+	public:
+		// LR states of the parse, one more than there are values until the parse is finished
+		[[nodiscard]] std::span<const std::uint32_t> states() const noexcept
+		{
+			return states_;
+		}
+
+		// Values on the stack
+		[[nodiscard]] size_t depth() const noexcept
+		{
+			return depth_;
+		}
+
+		// Terminal or non-terminal id of the value at index, counted from the bottom of the stack
+		[[nodiscard]] size_t symbol(size_t index) const noexcept
+		{
+			return symbols_[index].id;
+		}
+
+	private:
+		void reset()
+		{
+			states_.clear();
+			states_.push_back(0);
+			depth_ = 0;
+		}
+
+		// Slot of a new top value, whatever it holds is overwritten by the caller
+		[[nodiscard]] size_t push()
+		{
+			if (depth_ == std::size(values_))
+			{
+				values_.emplace_back();
+				symbols_.emplace_back();
+			}
+
+			return depth_++;
+		}
+
+		[[nodiscard]] std::span<Value> top(size_t count) noexcept
+		{
+			return std::span(values_).subspan(depth_ - count, count);
+		}
+	};
+}
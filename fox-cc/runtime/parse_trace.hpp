@@ -0,0 +1,152 @@
+#pragma once
+
+#include <vector>
+#include <span>
+#include <string_view>
+#include <ostream>
+#include <cstdint>
+
+#include <parser_compiler/parse_table.hpp>
+#include <runtime/parse_session.hpp>
+
+namespace fox_cc
+{
+	// Receives every step of compile(). begin() is called before the first token, shift() after a terminal is pushed and
+	// reduce() after a production is reduced, both with the stacks already updated. A trace may also have
+	// pop(session, production), called once the action has read the right-hand side and before it is popped
+	template<class Trace, class Value>
+	concept parse_trace = requires(Trace& trace, const parse_session<Value>& session, size_t id)
+	{
+		trace.begin();
+		trace.shift(session, id);
+		trace.reduce(session, id);
+	};
+
+	// Default of compile(), the calls compile away
+	struct no_trace
+	{
+		void begin() noexcept {}
+
+		template<class Value>
+		void shift(const parse_session<Value>&, size_t) noexcept {}
+
+		template<class Value>
+		void reduce(const parse_session<Value>&, size_t) noexcept {}
+	};
+
+	// Dumps the whole stack as text after every step, state [symbol] state [symbol] ..., the last state is missing
+	// once the parse is finished
+	class stream_trace
+	{
+		std::ostream* os_;
+
+	public:
+		explicit stream_trace(std::ostream& os) noexcept
+			: os_(&os) {}
+
+	public:
+		void begin()
+		{
+			*os_ << "node [symbol] node [symbol] ...\n";
+		}
+
+		template<class Value>
+		void shift(const parse_session<Value>& session, size_t)
+		{
+			dump(session);
+		}
+
+		template<class Value>
+		void reduce(const parse_session<Value>& session, size_t)
+		{
+			dump(session);
+		}
+
+	private:
+		template<class Value>
+		void dump(const parse_session<Value>& session)
+		{
+			const auto states = session.states();
+
+			for (size_t i = 0; i < session.depth(); ++i)
+			{
+				if (i < std::size(states))
+					*os_ << states[i] << ' ';
+
+				*os_ << '[' << session.symbol(i) << "] ";
+			}
+
+			if (session.depth() < std::size(states))
+				*os_ << states[session.depth()] << ' ';
+
+			*os_ << '\n';
+		}
+	};
+
+	enum class trace_event_kind : std::uint32_t
+	{
+		shift,
+		reduce
+	};
+
+	// Fixed-size record of one step
+	struct trace_event
+	{
+		trace_event_kind kind;
+		std::uint32_t id; // terminal shifted or production reduced
+		std::uint32_t state; // state on top of the stack after the step, goto_npos if the reduce finished the parse
+		std::uint32_t depth; // values on the stack after the step
+	};
+
+	// Step of the parser yielded by basic_compiler::events, views are valid until the generator is resumed
+	struct parse_event
+	{
+		trace_event_kind kind;
+		size_t id; // terminal shifted or production reduced
+		std::string_view lexeme; // shifted terminal's lexeme
+		std::span<const token_view> symbols; // reduced right-hand side, terminals with their lexemes, non-terminals without
+	};
+
+	// Records the steps as trace_events, a constant amount of work per step instead of a dump of the stack
+	class event_trace
+	{
+		std::vector<trace_event> events_;
+
+	public:
+		void begin() noexcept
+		{
+			events_.clear();
+		}
+
+		template<class Value>
+		void shift(const parse_session<Value>& session, size_t terminal)
+		{
+			record(trace_event_kind::shift, session, terminal);
+		}
+
+		template<class Value>
+		void reduce(const parse_session<Value>& session, size_t production)
+		{
+			record(trace_event_kind::reduce, session, production);
+		}
+
+		[[nodiscard]] std::span<const trace_event> events() const noexcept
+		{
+			return events_;
+		}
+
+	private:
+		template<class Value>
+		void record(trace_event_kind kind, const parse_session<Value>& session, size_t id)
+		{
+			const auto states = session.states();
+
+			events_.push_back(trace_event{
+				kind,
+				static_cast<std::uint32_t>(id),
+				std::size(states) > session.depth() ? states.back() : parse_table::goto_npos,
+				static_cast<std::uint32_t>(session.depth())
+			});
+		}
+	};
+}
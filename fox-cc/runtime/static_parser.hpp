@@ -0,0 +1,125 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <stdexcept>
+
+#include <runtime/parse_action.hpp>
+
+namespace fox_cc
+{
+	// LR driver over tables emitted by emit_parser_cpp, Tables is the generated tables struct
+	template<class Tables>
+	class static_parser
+	{
+		std::vector<std::uint32_t> states_; // reused between parses
+
+	public:
+		using tables = Tables;
+
+		static inline constexpr size_t end_token = 0;
+
+	public:
+		static_parser() = default;
+		static_parser(const static_parser&) = default;
+		static_parser(static_parser&&) noexcept = default;
+		static_parser& operator=(const static_parser&) = default;
+		static_parser& operator=(static_parser&&) noexcept = default;
+		~static_parser() noexcept = default;
+
+	private:
+		[[nodiscard]] static parse_action::entry action(size_t state, size_t terminal) noexcept
+		{
+			if constexpr (Tables::compressed)
+			{
+				const size_t i = Tables::action_base[state] + terminal;
+				return Tables::action_check[i] == state ? Tables::action_entries[i] : Tables::default_actions[state];
+			}
+			else
+			{
+				return Tables::actions[state * Tables::terminal_count + terminal];
+			}
+		}
+
+		[[nodiscard]] static std::uint32_t go_to(size_t state, size_t column) noexcept
+		{
+			if constexpr (Tables::compressed)
+			{
+				const size_t i = Tables::goto_base[column] + state;
+				return Tables::goto_check[i] == column ? Tables::goto_entries[i] : Tables::default_gotos[column];
+			}
+			else
+			{
+				return Tables::gotos[state * Tables::non_terminal_count + column];
+			}
+		}
+
+	public:
+		// next() returns the id of the next terminal, end_token at the end of the input. It is only called once the
+		// lookahead is needed, states with a default reduction reduce before it is read. shift(terminal) is called for
+		// every shifted terminal and reduce(production) for every reduce, which replaces the top
+		// Tables::production_length[production] values with one
+		template<class Next, class Shift, class Reduce>
+		void parse(Next&& next, Shift&& shift, Reduce&& reduce)
+		{
+			states_.clear();
+			states_.push_back(0);
+
+			size_t token = 0;
+			bool has_token = false;
+
+			auto lookahead = [&]()
+			{
+				if (!has_token)
+				{
+					token = next();
+					has_token = true;
+				}
+
+				return token;
+			};
+
+			while (true)
+			{
+				parse_action::entry entry = Tables::default_reductions[states_.back()];
+				if (entry == parse_action::error_entry)
+					entry = action(states_.back(), lookahead());
+
+				switch (parse_action::kind(entry))
+				{
+				case parse_action::action_kind::shift:
+					shift(token);
+					states_.push_back(static_cast<std::uint32_t>(parse_action::operand(entry)));
+					has_token = false;
+					break;
+
+				case parse_action::action_kind::reduce:
+				{
+					const size_t production = parse_action::operand(entry);
+					states_.resize(std::size(states_) - Tables::production_length[production]);
+
+					const auto to = go_to(states_.back(), Tables::production_lhs[production] - Tables::terminal_count);
+
+					// Reducing to a non-terminal the exposed state can't go to finishes the parse, at the end of the input
+					if (to == parse_action::goto_npos && lookahead() != end_token)
+						throw std::logic_error("Compilation error at token...");
+
+					reduce(production);
+
+					if (to == parse_action::goto_npos)
+						return;
+
+					states_.push_back(to);
+					break;
+				}
+
+				case parse_action::action_kind::accept:
+					return;
+
+				default:
+					throw std::logic_error("Compilation error at token...");
+				}
+			}
+		}
+	};
+}
@@ -0,0 +1,69 @@
+#include <runtime/tokenizer.hpp>
+
+void fox_cc::tokenizer::tokenize(std::string_view input, token_buffer& out) const
+{
+	out.clear();
+
+	auto s = scan(string_input(input));
+
+	for (auto t = s.next(); t.id != token::end_token; t = s.next())
+		out.push_back(t.id, t.begin, std::size(t.lexeme), s.reach() - t.begin - std::size(t.lexeme));
+}
+
+fox_cc::token_splice fox_cc::tokenizer::retokenize(std::string_view input, const text_edit& edit, token_buffer& tokens) const
+{
+	const auto [offset, removed, inserted] = edit;
+	const size_t count = std::size(tokens);
+
+	// First token ending past the offset
+	size_t first = 0;
+	for (size_t last = count; first < last; )
+	{
+		const size_t middle = first + (last - first) / 2;
+
+		if (tokens.end(middle) <= offset)
+			first = middle + 1;
+		else
+			last = middle;
+	}
+
+	// Tokens ending before the offset can still have been decided by reading into the edit
+	for (size_t i = first; i-- > 0 && tokens.end(i) + tokens.max_lookahead() > offset; )
+	{
+		if (tokens.end(i) + tokens.lookahead(i) > offset)
+			first = i;
+	}
+
+	const size_t restart = first < count ? tokens.begin(first) : (count > 0 ? tokens.end(count - 1) : 0);
+	auto s = scan(string_input(input.substr(restart)));
+
+	token_buffer fresh;
+	size_t last = first;
+
+	while (true)
+	{
+		const auto t = s.next();
+
+		if (t.id == token::end_token)
+		{
+			last = count;
+			break;
+		}
+
+		const size_t begin = restart + t.begin;
+
+		if (begin >= offset + inserted)
+		{
+			while (last < count && tokens.begin(last) + inserted < begin + removed)
+				++last;
+
+			if (last < count && tokens.begin(last) + inserted == begin + removed)
+				break;
+		}
+
+		fresh.push_back(t.id, begin, std::size(t.lexeme), s.reach() - t.begin - std::size(t.lexeme));
+	}
+
+	tokens.replace(first, last, fresh, static_cast<std::ptrdiff_t>(inserted) - static_cast<std::ptrdiff_t>(removed));
+	return token_splice{ first, last, std::size(fresh) };
+}
@@ -0,0 +1,633 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_set>
+#include <iterator>
+#include <cstdint>
+#include <limits>
+#include <algorithm>
+
+#include <lex_compiler/lex_compiler.hpp>
+#include <lex_compiler/lex_table.hpp>
+#include <runtime/input.hpp>
+
+namespace fox_cc
+{
+	enum class lexer_mode
+	{
+		backtracking, // rescans from the last accepted position, quadratic on pathological token sets
+		linear // remembers (state, position) pairs that can't reach an accept, never rescans them
+	};
+
+	struct token
+	{
+		static inline constexpr size_t end_token = 0; // id of the null-terminator returned at the end of the input
+
+		size_t id;
+		size_t begin; // offset of the lexeme in the input
+		std::string_view lexeme; // for streamed inputs valid until the next token is read
+	};
+
+	// Edit of a text, removed bytes at offset replaced by inserted ones
+	struct text_edit
+	{
+		size_t offset;
+		size_t removed;
+		size_t inserted;
+	};
+
+	// Tokens [first, last) of a buffer replaced by count tokens starting at first
+	struct token_splice
+	{
+		size_t first;
+		size_t last;
+		size_t count;
+	};
+
+	// Struct-of-arrays token storage, keeps its capacity between uses
+	class token_buffer
+	{
+		std::vector<std::uint32_t> ids_;
+		std::vector<size_t> begins_;
+		std::vector<std::uint32_t> lengths_;
+		std::vector<std::uint32_t> lookaheads_; // bytes past the end of the token the lexer read to decide it
+		std::uint32_t max_lookahead_ = 0; // bound of lookaheads_, not lowered by replace()
+
+	public:
+		token_buffer() = default;
+		token_buffer(const token_buffer&) = default;
+		token_buffer(token_buffer&&) noexcept = default;
+		token_buffer& operator=(const token_buffer&) = default;
+		token_buffer& operator=(token_buffer&&) noexcept = default;
+		~token_buffer() noexcept = default;
+
+	public:
+		[[nodiscard]] size_t size() const noexcept
+		{
+			return std::size(ids_);
+		}
+
+		[[nodiscard]] bool empty() const noexcept
+		{
+			return std::empty(ids_);
+		}
+
+		void clear() noexcept
+		{
+			ids_.clear();
+			begins_.clear();
+			lengths_.clear();
+			lookaheads_.clear();
+			max_lookahead_ = 0;
+		}
+
+		void reserve(size_t n)
+		{
+			ids_.reserve(n);
+			begins_.reserve(n);
+			lengths_.reserve(n);
+			lookaheads_.reserve(n);
+		}
+
+		void push_back(size_t id, size_t begin, size_t length, size_t lookahead = 0)
+		{
+			ids_.push_back(static_cast<std::uint32_t>(id));
+			begins_.push_back(begin);
+			lengths_.push_back(static_cast<std::uint32_t>(length));
+			lookaheads_.push_back(static_cast<std::uint32_t>(lookahead));
+			max_lookahead_ = std::max(max_lookahead_, lookaheads_.back());
+		}
+
+		// Replaces the tokens [first, last) with the tokens of other, the begins of the tokens after them move by shift
+		void replace(size_t first, size_t last, const token_buffer& other, std::ptrdiff_t shift)
+		{
+			const auto splice = [&](auto& column, const auto& with)
+			{
+				column.erase(std::begin(column) + first, std::begin(column) + last);
+				column.insert(std::begin(column) + first, std::begin(with), std::end(with));
+			};
+
+			splice(ids_, other.ids_);
+			splice(begins_, other.begins_);
+			splice(lengths_, other.lengths_);
+			splice(lookaheads_, other.lookaheads_);
+			max_lookahead_ = std::max(max_lookahead_, other.max_lookahead_);
+
+			for (size_t i = first + std::size(other); i < std::size(begins_); ++i)
+				begins_[i] = static_cast<size_t>(static_cast<std::ptrdiff_t>(begins_[i]) + shift);
+		}
+
+	public:
+		[[nodiscard]] std::span<const std::uint32_t> ids() const noexcept
+		{
+			return ids_;
+		}
+
+		[[nodiscard]] std::span<const size_t> begins() const noexcept
+		{
+			return begins_;
+		}
+
+		[[nodiscard]] std::span<const std::uint32_t> lengths() const noexcept
+		{
+			return lengths_;
+		}
+
+		[[nodiscard]] size_t id(size_t i) const noexcept
+		{
+			return ids_[i];
+		}
+
+		[[nodiscard]] size_t begin(size_t i) const noexcept
+		{
+			return begins_[i];
+		}
+
+		[[nodiscard]] size_t length(size_t i) const noexcept
+		{
+			return lengths_[i];
+		}
+
+		[[nodiscard]] size_t end(size_t i) const noexcept
+		{
+			return begins_[i] + lengths_[i];
+		}
+
+		[[nodiscard]] size_t lookahead(size_t i) const noexcept
+		{
+			return lookaheads_[i];
+		}
+
+		[[nodiscard]] size_t max_lookahead() const noexcept
+		{
+			return max_lookahead_;
+		}
+	};
+
+	// Runtime lexer, splits inputs into tokens of a lex_compiler_result with maximal munch
+	class tokenizer
+	{
+		lex_table table_;
+		lexer_mode mode_ = lexer_mode::backtracking;
+
+	public:
+		// Lexes a single input, owns the input and the state between tokens
+		template<class Input>
+		class scanner
+		{
+			const tokenizer* tokenizer_;
+			Input input_;
+			size_t position_ = 0;
+
+			std::unordered_set<size_t> failed_; // (state, position) pairs that can't reach an accept, linear mode only
+			size_t failed_end_ = 0; // past the last position recorded in failed_
+			std::vector<std::pair<size_t, size_t>> trail_; // (state, position) pairs since the last accept, linear mode only
+			size_t reach_ = 0; // past the furthest position the last token was decided by
+			size_t furthest_ = 0; // past the furthest position read since failed_ was cleared, linear mode only
+
+		public:
+			scanner() = delete;
+
+			scanner(const tokenizer& tokenizer, Input input)
+				: tokenizer_(std::addressof(tokenizer)), input_(std::move(input)) {}
+
+			scanner(const scanner&) = delete;
+			scanner(scanner&&) noexcept = default;
+			scanner& operator=(const scanner&) = delete;
+			scanner& operator=(scanner&&) noexcept = default;
+			~scanner() noexcept = default;
+
+		public:
+			[[nodiscard]] Input& input() noexcept
+			{
+				return input_;
+			}
+
+			[[nodiscard]] size_t position() const noexcept
+			{
+				return position_;
+			}
+
+			// Past the furthest position, the end of the input included, the last token depends on. Edits at or after
+			// it can't change the token
+			[[nodiscard]] size_t reach() const noexcept
+			{
+				return reach_;
+			}
+
+			// Returns the next token, token::end_token at the end of the input. Releases the previous token from the input
+			[[nodiscard]] token next()
+			{
+				input_.release(position_);
+				reach_ = position_;
+
+				return tokenizer_->table_.visit([&](const auto& table) -> token
+				{
+					if (tokenizer_->mode_ == lexer_mode::linear)
+						return next_linear(table);
+
+					return next_backtracking(table);
+				});
+			}
+
+		private:
+			[[nodiscard]] token end_of_input(size_t ts)
+			{
+				if (ts != position_ || input_.fetch(ts))
+					throw "Unknown token\n";
+
+				return token{ token::end_token, position_, {} };
+			}
+
+			template<class View>
+			[[nodiscard]] token next_backtracking(const View& table)
+			{
+				using state_type = typename View::state_type;
+
+				const size_t ts = position_;
+
+				auto state = static_cast<state_type>(tokenizer_->table_.start());
+				size_t potential_reduce_i = std::numeric_limits<size_t>::max();
+				state_type potential_reduce_node = state;
+
+				for (size_t i = ts; ; ++i)
+				{
+					const bool at_end = !input_.fetch(i);
+					reach_ = std::max(reach_, i + 1);
+
+					const auto reduce = table.accept(state);
+
+					if (reduce != lex_table::token_npos)
+					{
+						if (potential_reduce_i == i) // Reduce
+						{
+							position_ = i;
+							return token{ reduce, ts, input_.view(ts, i) };
+						}
+						else // Try matching longer string
+						{
+							potential_reduce_i = i;
+							potential_reduce_node = state;
+						}
+					}
+
+					if (at_end && potential_reduce_i == std::numeric_limits<size_t>::max())
+						return end_of_input(ts);
+
+					const auto next_state = at_end ? table.state_npos :
+						table.next(state, static_cast<unsigned char>(input_[i]));
+
+					if (next_state != table.state_npos)
+					{
+						state = next_state;
+					}
+					else
+					{
+						if (potential_reduce_i == std::numeric_limits<size_t>::max())
+						{
+							throw "Unknown token\n";
+						}
+						else
+						{
+							i = potential_reduce_i - 1;
+							state = potential_reduce_node;
+						}
+					}
+				}
+			}
+
+			template<class View>
+			[[nodiscard]] token next_linear(const View& table)
+			{
+				// Reps' maximal munch, runs forward until the DFA dies or hits a pair known to fail, then
+				// pops back to the last accept marking everything popped as failed
+				using state_type = typename View::state_type;
+
+				const size_t ts = position_;
+				const size_t state_count = tokenizer_->table_.size();
+
+				if (ts >= failed_end_)
+				{
+					failed_.clear(); // no later scan can reach the recorded positions
+					furthest_ = 0;
+				}
+
+				auto state = static_cast<state_type>(tokenizer_->table_.start());
+				trail_.clear();
+
+				for (size_t i = ts; ; ++i)
+				{
+					if (failed_.contains(i * state_count + state))
+					{
+						reach_ = std::max(reach_, furthest_); // the failure was found by reading that far
+						break;
+					}
+
+					if (table.accept(state) != lex_table::token_npos)
+						trail_.clear();
+
+					trail_.emplace_back(state, i);
+
+					reach_ = std::max(reach_, i + 1);
+					furthest_ = std::max(furthest_, i + 1);
+
+					if (!input_.fetch(i))
+						break;
+
+					state = table.next(state, static_cast<unsigned char>(input_[i]));
+
+					if (state == table.state_npos)
+						break;
+				}
+
+				while (!std::empty(trail_) && table.accept(static_cast<state_type>(trail_.back().first)) == lex_table::token_npos)
+				{
+					const auto [s, i] = trail_.back();
+					failed_.insert(i * state_count + s);
+					failed_end_ = std::max(failed_end_, i + 1);
+					trail_.pop_back();
+				}
+
+				if (std::empty(trail_) || trail_.back().second == ts)
+					return end_of_input(ts);
+
+				const auto [accept_state, accept_i] = trail_.back();
+
+				position_ = accept_i;
+				return token{ table.accept(static_cast<state_type>(accept_state)), ts, input_.view(ts, accept_i) };
+			}
+		};
+
+		// Range of the tokens of an input, the end token is not included
+		template<class Input>
+		class token_range
+		{
+			scanner<Input> scanner_;
+			token current_ = {};
+
+		public:
+			class iterator
+			{
+				token_range* range_ = nullptr;
+
+			public:
+				using iterator_concept = std::input_iterator_tag;
+				using value_type = token;
+				using difference_type = std::ptrdiff_t;
+
+				iterator() = default;
+
+				explicit iterator(token_range* range) noexcept
+					: range_(range) {}
+
+				[[nodiscard]] const token& operator*() const noexcept
+				{
+					return range_->current_;
+				}
+
+				[[nodiscard]] const token* operator->() const noexcept
+				{
+					return std::addressof(range_->current_);
+				}
+
+				iterator& operator++()
+				{
+					range_->current_ = range_->scanner_.next();
+					return *this;
+				}
+
+				void operator++(int)
+				{
+					++*this;
+				}
+
+				[[nodiscard]] bool operator==(std::default_sentinel_t) const noexcept
+				{
+					return range_->current_.id == token::end_token;
+				}
+			};
+
+		public:
+			token_range(const tokenizer& tokenizer, Input input)
+				: scanner_(tokenizer, std::move(input)) {}
+
+			[[nodiscard]] iterator begin()
+			{
+				current_ = scanner_.next();
+				return iterator(this);
+			}
+
+			[[nodiscard]] std::default_sentinel_t end() const noexcept
+			{
+				return {};
+			}
+		};
+
+		// Lexes an input fed in fragments. The DFA state is kept between feeds, tokens are reported as soon as the DFA
+		// dies past them and only the bytes since the start of the unfinished token are kept. In linear mode
+		// the failed pairs are keyed on absolute positions so they outlive the bytes dropped between feeds
+		class push_scanner
+		{
+			const tokenizer* tokenizer_;
+
+			std::string pending_; // bytes since the start of the unfinished token
+			size_t offset_ = 0; // absolute position of pending_[0]
+			size_t position_ = 0; // next byte of pending_ to run through the DFA
+			size_t state_ = 0;
+			size_t accept_id_ = lex_table::token_npos; // longest match of the unfinished token so far
+			size_t accept_end_ = 0;
+
+			std::unordered_set<size_t> failed_; // (state, absolute position) pairs that can't reach an accept, linear mode only
+			size_t failed_end_ = 0; // past the last position recorded in failed_
+			std::vector<std::pair<size_t, size_t>> trail_; // (state, absolute position) pairs since the last accept, linear mode only
+
+		public:
+			push_scanner() = delete;
+
+			explicit push_scanner(const tokenizer& tokenizer)
+				: tokenizer_(std::addressof(tokenizer)), state_(tokenizer.table_.start()) {}
+
+			push_scanner(const push_scanner&) = default;
+			push_scanner(push_scanner&&) noexcept = default;
+			push_scanner& operator=(const push_scanner&) = default;
+			push_scanner& operator=(push_scanner&&) noexcept = default;
+			~push_scanner() noexcept = default;
+
+		public:
+			// Calls out(token) for every token the bytes complete, lexemes are valid only for the duration of the call
+			template<class Out>
+			void feed(std::string_view bytes, Out&& out)
+			{
+				pending_.append(bytes);
+				scan(false, out);
+			}
+
+			// Ends the input, calls out(token) for the remaining tokens and then for the end token. The scanner is
+			// ready for the next input afterwards
+			template<class Out>
+			void finish(Out&& out)
+			{
+				scan(true, out);
+				out(token{ token::end_token, offset_ + position_, {} });
+				reset();
+			}
+
+			void reset() noexcept
+			{
+				pending_.clear();
+				offset_ = 0;
+				position_ = 0;
+				state_ = tokenizer_->table_.start();
+				accept_id_ = lex_table::token_npos;
+				failed_.clear();
+				failed_end_ = 0;
+				trail_.clear();
+			}
+
+		private:
+			template<class Out>
+			void scan(bool at_end, Out& out)
+			{
+				tokenizer_->table_.visit([&](const auto& table)
+				{
+					using state_type = typename std::remove_cvref_t<decltype(table)>::state_type;
+
+					const bool linear = tokenizer_->mode_ == lexer_mode::linear;
+					const size_t state_count = tokenizer_->table_.size();
+
+					size_t start = 0;
+					auto state = static_cast<state_type>(state_);
+
+					while (true)
+					{
+						if (position_ < std::size(pending_))
+						{
+							const size_t i = offset_ + position_;
+
+							// A failed pair can't reach another accept, the DFA may as well have died there
+							if (!linear || !failed_.contains(i * state_count + state))
+							{
+								if (linear)
+									trail_.emplace_back(state, i);
+
+								const auto next_state = table.next(state, static_cast<unsigned char>(pending_[position_]));
+
+								if (next_state != table.state_npos)
+								{
+									state = next_state;
+									++position_;
+
+									if (const auto id = table.accept(state); id != lex_table::token_npos)
+									{
+										accept_id_ = id;
+										accept_end_ = position_;
+										trail_.clear();
+									}
+
+									continue;
+								}
+							}
+						}
+						else if (!at_end || start == std::size(pending_))
+						{
+							break; // the unfinished token may still grow
+						}
+
+						// The DFA died or the input ended, the longest match is the token and nothing run through
+						// since can reach an accept
+						for (const auto [s, i] : trail_)
+						{
+							failed_.insert(i * state_count + s);
+							failed_end_ = std::max(failed_end_, i + 1);
+						}
+
+						trail_.clear();
+
+						if (accept_id_ == lex_table::token_npos)
+							throw "Unknown token\n";
+
+						out(token{ accept_id_, offset_ + start, std::string_view(pending_).substr(start, accept_end_ - start) });
+
+						start = position_ = accept_end_;
+						state = static_cast<state_type>(tokenizer_->table_.start());
+						accept_id_ = lex_table::token_npos;
+
+						if (offset_ + start >= failed_end_)
+							failed_.clear(); // no later scan can reach the recorded positions
+					}
+
+					state_ = state;
+
+					pending_.erase(0, start);
+					offset_ += start;
+					position_ -= start;
+					accept_end_ -= std::min(accept_end_, start);
+				});
+			}
+		};
+
+	public:
+		tokenizer() = default;
+		tokenizer(const tokenizer&) = default;
+		tokenizer(tokenizer&&) noexcept = default;
+		tokenizer& operator=(const tokenizer&) = default;
+		tokenizer& operator=(tokenizer&&) noexcept = default;
+		~tokenizer() noexcept = default;
+
+	public:
+		explicit tokenizer(const lex_compiler::lex_compiler_result& lex_result, lexer_mode mode = lexer_mode::backtracking)
+			: table_(lex_result), mode_(mode) {}
+
+		explicit tokenizer(lex_table table, lexer_mode mode = lexer_mode::backtracking)
+			: table_(std::move(table)), mode_(mode) {}
+
+	public:
+		[[nodiscard]] const lex_table& table() const noexcept
+		{
+			return table_;
+		}
+
+		[[nodiscard]] lexer_mode mode() const noexcept
+		{
+			return mode_;
+		}
+
+		void set_mode(lexer_mode mode) noexcept
+		{
+			mode_ = mode;
+		}
+
+	public:
+		template<class Input>
+		[[nodiscard]] scanner<Input> scan(Input input) const
+		{
+			return scanner<Input>(*this, std::move(input));
+		}
+
+		[[nodiscard]] token_range<string_input> tokens(std::string_view input) const
+		{
+			return token_range<string_input>(*this, string_input(input));
+		}
+
+		[[nodiscard]] token_range<chunked_input> tokens(chunk_source source) const
+		{
+			return token_range<chunked_input>(*this, chunked_input(std::move(source)));
+		}
+
+		[[nodiscard]] push_scanner push_scan() const
+		{
+			return push_scanner(*this);
+		}
+
+		// Replaces the buffer's contents with the tokens of the input, the end token is not included
+		void tokenize(std::string_view input, token_buffer& out) const;
+
+		// Updates the tokens of a text after the edit, input is the edited text. Relexes from the last token boundary
+		// the edit can't have affected until a new token starts where an old one did past the edit, the bytes and so
+		// the tokens from there on are the same. Returns the tokens replaced, the buffer is unchanged if it throws
+		token_splice retokenize(std::string_view input, const text_edit& edit, token_buffer& tokens) const;
+	};
+}